@@ -19,25 +19,54 @@
 
 #include "BPTC19696.h"
 
+#include "FECTables.h"
 #include "Hamming.h"
-#include "Utils.h"
 
 #include <cstdio>
 #include <cassert>
 #include <cstring>
 
-CBPTC19696::CBPTC19696() :
-m_rawData(NULL),
-m_deInterData(NULL)
+// For each position of the deinterleaved block, the byte and bit shift in the burst
+// it is found in. The interleave sequence is (a * 181) % 196, with the raw bits
+// 98 and 99 in the two low bits of byte 20.
+static constexpr unsigned int burstPosition(unsigned int a)
 {
-	m_rawData     = new bool[196];
-	m_deInterData = new bool[196];
+	unsigned int pos = (a * 181U) % 196U;
+
+	return pos < 98U ? pos : pos + 68U;
+}
+
+static constexpr CLookupTable<unsigned char, 196U> makeInterleaveByte()
+{
+	CLookupTable<unsigned char, 196U> table = {};
+	for (unsigned int a = 0U; a < 196U; a++)
+		table.m_value[a] = (unsigned char)(burstPosition(a) / 8U);
+
+	return table;
+}
+
+static constexpr CLookupTable<unsigned char, 196U> makeInterleaveShift()
+{
+	CLookupTable<unsigned char, 196U> table = {};
+	for (unsigned int a = 0U; a < 196U; a++)
+		table.m_value[a] = (unsigned char)(7U - burstPosition(a) % 8U);
+
+	return table;
+}
+
+static constexpr CLookupTable<unsigned char, 196U> INTERLEAVE_BYTE  = makeInterleaveByte();
+static constexpr CLookupTable<unsigned char, 196U> INTERLEAVE_SHIFT = makeInterleaveShift();
+
+static_assert(CFECTables::hash(INTERLEAVE_BYTE) == 0xE7001A2DU, "BPTC interleave byte table mismatch");
+static_assert(CFECTables::hash(INTERLEAVE_SHIFT) == 0x3DEB8449U, "BPTC interleave shift table mismatch");
+
+CBPTC19696::CBPTC19696()
+{
+	::memset(m_rows, 0x00U, 13U * sizeof(unsigned int));
 }
 
 CBPTC19696::~CBPTC19696()
 {
-	delete[] m_rawData;
-	delete[] m_deInterData;
 }
 
 // The main decode function
@@ -46,12 +75,9 @@ void CBPTC19696::decode(const unsigned char* in, unsigned char* out)
 	assert(in != NULL);
 	assert(out != NULL);
 
-	//  Get the raw binary
+	//  Get the raw binary and deinterleave it
 	decodeExtractBinary(in);
 
-	// Deinterleave
-	decodeDeInterleave();
-
 	// Error check
 	decodeErrorCheck();
 
@@ -71,98 +97,67 @@ void CBPTC19696::encode(const unsigned char* in, unsigned char* out)
 	// Error check
 	encodeErrorCheck();
 
-	// Deinterleave
-	encodeInterleave();
-
-	//  Get the raw binary
+	// Interleave and get the raw binary
 	encodeExtractBinary(out);
 }
 
 void CBPTC19696::decodeExtractBinary(const unsigned char* in)
 {
-	// First block
-	CUtils::byteToBitsBE(in[0U],  m_rawData + 0U);
-	CUtils::byteToBitsBE(in[1U],  m_rawData + 8U);
-	CUtils::byteToBitsBE(in[2U],  m_rawData + 16U);
-	CUtils::byteToBitsBE(in[3U],  m_rawData + 24U);
-	CUtils::byteToBitsBE(in[4U],  m_rawData + 32U);
-	CUtils::byteToBitsBE(in[5U],  m_rawData + 40U);
-	CUtils::byteToBitsBE(in[6U],  m_rawData + 48U);
-	CUtils::byteToBitsBE(in[7U],  m_rawData + 56U);
-	CUtils::byteToBitsBE(in[8U],  m_rawData + 64U);
-	CUtils::byteToBitsBE(in[9U],  m_rawData + 72U);
-	CUtils::byteToBitsBE(in[10U], m_rawData + 80U);
-	CUtils::byteToBitsBE(in[11U], m_rawData + 88U);
-	CUtils::byteToBitsBE(in[12U], m_rawData + 96U);
-
-	// Handle the two bits
-	bool bits[8U];
-	CUtils::byteToBitsBE(in[20U], bits);
-	m_rawData[98U] = bits[6U];
-	m_rawData[99U] = bits[7U];
-
-	// Second block
-	CUtils::byteToBitsBE(in[21U], m_rawData + 100U);
-	CUtils::byteToBitsBE(in[22U], m_rawData + 108U);
-	CUtils::byteToBitsBE(in[23U], m_rawData + 116U);
-	CUtils::byteToBitsBE(in[24U], m_rawData + 124U);
-	CUtils::byteToBitsBE(in[25U], m_rawData + 132U);
-	CUtils::byteToBitsBE(in[26U], m_rawData + 140U);
-	CUtils::byteToBitsBE(in[27U], m_rawData + 148U);
-	CUtils::byteToBitsBE(in[28U], m_rawData + 156U);
-	CUtils::byteToBitsBE(in[29U], m_rawData + 164U);
-	CUtils::byteToBitsBE(in[30U], m_rawData + 172U);
-	CUtils::byteToBitsBE(in[31U], m_rawData + 180U);
-	CUtils::byteToBitsBE(in[32U], m_rawData + 188U);
-}
-
-// Deinterleave the raw data
-void CBPTC19696::decodeDeInterleave()
-{
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_deInterData[i] = false;
-
 	// The first bit is R(3) which is not used so can be ignored
-	for (unsigned int a = 0U; a < 196U; a++)	{
-		// Calculate the interleave sequence
-		unsigned int interleaveSequence = (a * 181U) % 196U;
-		// Shuffle the data
-		m_deInterData[a] = m_rawData[interleaveSequence];
+	unsigned int a = 1U;
+	for (unsigned int r = 0U; r < 13U; r++) {
+		unsigned int row = 0U;
+		for (unsigned int c = 0U; c < 15U; c++, a++)
+			row = (row << 1) | ((in[INTERLEAVE_BYTE[a]] >> INTERLEAVE_SHIFT[a]) & 0x01U);
+
+		m_rows[r] = row;
 	}
 }
-	
+
 // Check each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
 void CBPTC19696::decodeErrorCheck()
 {
+	const unsigned int* r = m_rows;
+
 	bool fixing;
 	unsigned int count = 0U;
 	do {
 		fixing = false;
 
-		// Run through each of the 15 columns
-		bool col[13U];
-		for (unsigned int c = 0U; c < 15U; c++) {
-			unsigned int pos = c + 1U;
-			for (unsigned int a = 0U; a < 13U; a++) {
-				col[a] = m_deInterData[pos];
-				pos = pos + 15U;
-			}
+		// The syndromes of all 15 columns at once, a column only needs fixing when it is not zero
+		unsigned int s0 = r[0U] ^ r[1U] ^ r[3U] ^ r[5U] ^ r[6U] ^ r[9U];
+		unsigned int s1 = r[0U] ^ r[1U] ^ r[2U] ^ r[4U] ^ r[6U] ^ r[7U] ^ r[10U];
+		unsigned int s2 = r[0U] ^ r[1U] ^ r[2U] ^ r[3U] ^ r[5U] ^ r[7U] ^ r[8U] ^ r[11U];
+		unsigned int s3 = r[0U] ^ r[2U] ^ r[4U] ^ r[5U] ^ r[8U] ^ r[12U];
+
+		unsigned int errors = s0 | s1 | s2 | s3;
+
+		for (unsigned int c = 0U; errors != 0U && c < 15U; c++) {
+			unsigned int mask = 0x4000U >> c;
+			if ((errors & mask) == 0U)
+				continue;
+
+			unsigned int col = 0U;
+			for (unsigned int a = 0U; a < 13U; a++)
+				col = (col << 1) | ((m_rows[a] & mask) != 0U ? 1U : 0U);
 
 			if (CHamming::decode1393(col)) {
-				unsigned int pos = c + 1U;
 				for (unsigned int a = 0U; a < 13U; a++) {
-					m_deInterData[pos] = col[a];
-					pos = pos + 15U;
+					if ((col & (0x1000U >> a)) != 0U)
+						m_rows[a] |= mask;
+					else
+						m_rows[a] &= ~mask;
 				}
 
 				fixing = true;
 			}
+
+			errors &= ~mask;
 		}
-		
+
 		// Run through each of the 9 rows containing data
-		for (unsigned int r = 0U; r < 9U; r++) {
-			unsigned int pos = (r * 15U) + 1U;
-			if (CHamming::decode15113_2(m_deInterData + pos))
+		for (unsigned int i = 0U; i < 9U; i++) {
+			if (CHamming::decode15113_2(m_rows[i]))
 				fixing = true;
 		}
 
@@ -170,178 +165,75 @@ void CBPTC19696::decodeErrorCheck()
 	} while (fixing && count < 5U);
 }
 
-// Extract the 96 bits of payload
+// Extract the 96 bits of payload, the last eight bits of the first row and the first eleven of the next eight
 void CBPTC19696::decodeExtractData(unsigned char* data) const
 {
-	bool bData[96U];
-	unsigned int pos = 0U;
-	for (unsigned int a = 4U; a <= 11U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 16U; a <= 26U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 31U; a <= 41U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 46U; a <= 56U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 61U; a <= 71U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 76U; a <= 86U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 91U; a <= 101U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 106U; a <= 116U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	for (unsigned int a = 121U; a <= 131U; a++, pos++)
-		bData[pos] = m_deInterData[a];
-
-	CUtils::bitsToByteBE(bData + 0U,  data[0U]);
-	CUtils::bitsToByteBE(bData + 8U,  data[1U]);
-	CUtils::bitsToByteBE(bData + 16U, data[2U]);
-	CUtils::bitsToByteBE(bData + 24U, data[3U]);
-	CUtils::bitsToByteBE(bData + 32U, data[4U]);
-	CUtils::bitsToByteBE(bData + 40U, data[5U]);
-	CUtils::bitsToByteBE(bData + 48U, data[6U]);
-	CUtils::bitsToByteBE(bData + 56U, data[7U]);
-	CUtils::bitsToByteBE(bData + 64U, data[8U]);
-	CUtils::bitsToByteBE(bData + 72U, data[9U]);
-	CUtils::bitsToByteBE(bData + 80U, data[10U]);
-	CUtils::bitsToByteBE(bData + 88U, data[11U]);
-}
+	unsigned int acc  = (m_rows[0U] >> 4) & 0xFFU;
+	unsigned int bits = 8U;
+	unsigned int n    = 0U;
 
-// Extract the 96 bits of payload
-void CBPTC19696::encodeExtractData(const unsigned char* in) const
-{
-	bool bData[96U];
-	CUtils::byteToBitsBE(in[0U],  bData + 0U);
-	CUtils::byteToBitsBE(in[1U],  bData + 8U);
-	CUtils::byteToBitsBE(in[2U],  bData + 16U);
-	CUtils::byteToBitsBE(in[3U],  bData + 24U);
-	CUtils::byteToBitsBE(in[4U],  bData + 32U);
-	CUtils::byteToBitsBE(in[5U],  bData + 40U);
-	CUtils::byteToBitsBE(in[6U],  bData + 48U);
-	CUtils::byteToBitsBE(in[7U],  bData + 56U);
-	CUtils::byteToBitsBE(in[8U],  bData + 64U);
-	CUtils::byteToBitsBE(in[9U],  bData + 72U);
-	CUtils::byteToBitsBE(in[10U], bData + 80U);
-	CUtils::byteToBitsBE(in[11U], bData + 88U);
-
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_deInterData[i] = false;
-
-	unsigned int pos = 0U;
-	for (unsigned int a = 4U; a <= 11U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 16U; a <= 26U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 31U; a <= 41U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 46U; a <= 56U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 61U; a <= 71U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 76U; a <= 86U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 91U; a <= 101U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 106U; a <= 116U; a++, pos++)
-		m_deInterData[a] = bData[pos];
-
-	for (unsigned int a = 121U; a <= 131U; a++, pos++)
-		m_deInterData[a] = bData[pos];
+	for (unsigned int r = 1U; r < 9U; r++) {
+		acc   = (acc << 11) | ((m_rows[r] >> 4) & 0x7FFU);
+		bits += 11U;
+
+		while (bits >= 8U) {
+			bits -= 8U;
+			data[n++] = (acc >> bits) & 0xFFU;
+		}
+	}
 }
 
-// Check each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
-void CBPTC19696::encodeErrorCheck()
+// Insert the 96 bits of payload
+void CBPTC19696::encodeExtractData(const unsigned char* in)
 {
-	
-	// Run through each of the 9 rows containing data
-	for (unsigned int r = 0U; r < 9U; r++) {
-		unsigned int pos = (r * 15U) + 1U;
-		CHamming::encode15113_2(m_deInterData + pos);
-	}
-	
-	// Run through each of the 15 columns
-	bool col[13U];
-	for (unsigned int c = 0U; c < 15U; c++) {
-		unsigned int pos = c + 1U;
-		for (unsigned int a = 0U; a < 13U; a++) {
-			col[a] = m_deInterData[pos];
-			pos = pos + 15U;
-		}
+	::memset(m_rows, 0x00U, 13U * sizeof(unsigned int));
 
-		CHamming::encode1393(col);
+	m_rows[0U] = in[0U] << 4;
 
-		pos = c + 1U;
-		for (unsigned int a = 0U; a < 13U; a++) {
-			m_deInterData[pos] = col[a];
-			pos = pos + 15U;
+	unsigned int acc  = 0U;
+	unsigned int bits = 0U;
+	unsigned int n    = 1U;
+
+	for (unsigned int r = 1U; r < 9U; r++) {
+		while (bits < 11U) {
+			acc   = (acc << 8) | in[n++];
+			bits += 8U;
 		}
+
+		bits -= 11U;
+		m_rows[r] = ((acc >> bits) & 0x7FFU) << 4;
 	}
 }
 
-// Interleave the raw data
-void CBPTC19696::encodeInterleave()
+// Check each row with a Hamming (15,11,3) code and each column with a Hamming (13,9,3) code
+void CBPTC19696::encodeErrorCheck()
 {
-	for (unsigned int i = 0U; i < 196U; i++)
-		m_rawData[i] = false;
+	unsigned int* r = m_rows;
 
-	// The first bit is R(3) which is not used so can be ignored
-	for (unsigned int a = 0U; a < 196U; a++)	{
-		// Calculate the interleave sequence
-		unsigned int interleaveSequence = (a * 181U) % 196U;
-		// Unshuffle the data
-		m_rawData[interleaveSequence] = m_deInterData[a];
-	}
+	// Run through each of the 9 rows containing data
+	for (unsigned int i = 0U; i < 9U; i++)
+		r[i] = CHamming::encode15113_2(r[i]);
+
+	// The parity rows cover all 15 columns at once
+	r[9U]  = r[0U] ^ r[1U] ^ r[3U] ^ r[5U] ^ r[6U];
+	r[10U] = r[0U] ^ r[1U] ^ r[2U] ^ r[4U] ^ r[6U] ^ r[7U];
+	r[11U] = r[0U] ^ r[1U] ^ r[2U] ^ r[3U] ^ r[5U] ^ r[7U] ^ r[8U];
+	r[12U] = r[0U] ^ r[2U] ^ r[4U] ^ r[5U] ^ r[8U];
 }
 
-void CBPTC19696::encodeExtractBinary(unsigned char* data)
+void CBPTC19696::encodeExtractBinary(unsigned char* data) const
 {
-	// First block
-	CUtils::bitsToByteBE(m_rawData + 0U,  data[0U]);
-	CUtils::bitsToByteBE(m_rawData + 8U,  data[1U]);
-	CUtils::bitsToByteBE(m_rawData + 16U, data[2U]);
-	CUtils::bitsToByteBE(m_rawData + 24U, data[3U]);
-	CUtils::bitsToByteBE(m_rawData + 32U, data[4U]);
-	CUtils::bitsToByteBE(m_rawData + 40U, data[5U]);
-	CUtils::bitsToByteBE(m_rawData + 48U, data[6U]);
-	CUtils::bitsToByteBE(m_rawData + 56U, data[7U]);
-	CUtils::bitsToByteBE(m_rawData + 64U, data[8U]);
-	CUtils::bitsToByteBE(m_rawData + 72U, data[9U]);
-	CUtils::bitsToByteBE(m_rawData + 80U, data[10U]);
-	CUtils::bitsToByteBE(m_rawData + 88U, data[11U]);
-
-	// Handle the two bits
-	unsigned char byte;
-	CUtils::bitsToByteBE(m_rawData + 96U, byte);
-	data[12U] = (data[12U] & 0x3FU) | ((byte >> 0) & 0xC0U);
-	data[20U] = (data[20U] & 0xFCU) | ((byte >> 4) & 0x03U);
-
-	// Second block
-	CUtils::bitsToByteBE(m_rawData + 100U,  data[21U]);
-	CUtils::bitsToByteBE(m_rawData + 108U,  data[22U]);
-	CUtils::bitsToByteBE(m_rawData + 116U,  data[23U]);
-	CUtils::bitsToByteBE(m_rawData + 124U,  data[24U]);
-	CUtils::bitsToByteBE(m_rawData + 132U,  data[25U]);
-	CUtils::bitsToByteBE(m_rawData + 140U,  data[26U]);
-	CUtils::bitsToByteBE(m_rawData + 148U,  data[27U]);
-	CUtils::bitsToByteBE(m_rawData + 156U,  data[28U]);
-	CUtils::bitsToByteBE(m_rawData + 164U,  data[29U]);
-	CUtils::bitsToByteBE(m_rawData + 172U,  data[30U]);
-	CUtils::bitsToByteBE(m_rawData + 180U,  data[31U]);
-	CUtils::bitsToByteBE(m_rawData + 188U,  data[32U]);
+	// Only the two bits in each of bytes 12 and 20 belong to the block
+	::memset(data + 0U,  0x00U, 12U);
+	::memset(data + 21U, 0x00U, 12U);
+	data[12U] &= 0x3FU;
+	data[20U] &= 0xFCU;
+
+	// The first bit is R(3) which is always zero
+	unsigned int a = 1U;
+	for (unsigned int r = 0U; r < 13U; r++) {
+		unsigned int row = m_rows[r];
+		for (unsigned int c = 0U; c < 15U; c++, a++)
+			data[INTERLEAVE_BYTE[a]] |= ((row >> (14U - c)) & 0x01U) << INTERLEAVE_SHIFT[a];
+	}
 }
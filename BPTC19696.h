@@ -19,6 +19,8 @@
 #if !defined(BPTC19696_H)
 #define	BPTC19696_H
 
+// The 196 bit block is kept as 13 rows of 15 bits, column 0 in bit 14 of each
+// row, which skips the unused R(3) bit at the start of the block.
 class CBPTC19696
 {
 public:
@@ -30,18 +32,15 @@ public:
 	void encode(const unsigned char* in, unsigned char* out);
 
 private:
-	bool* m_rawData;
-	bool* m_deInterData;
+	unsigned int m_rows[13U];
 
 	void decodeExtractBinary(const unsigned char* in);
 	void decodeErrorCheck();
-	void decodeDeInterleave();
 	void decodeExtractData(unsigned char* data) const;
 
-	void encodeExtractData(const unsigned char* in) const;
-	void encodeInterleave();
+	void encodeExtractData(const unsigned char* in);
 	void encodeErrorCheck();
-	void encodeExtractBinary(unsigned char* data);
+	void encodeExtractBinary(unsigned char* data) const;
 };
 
 #endif
@@ -0,0 +1,173 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#ifndef BitPermutation_H
+#define BitPermutation_H
+
+#include "CPUFeatures.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(CPU_DISPATCH_X86_64)
+#include <immintrin.h>
+#endif
+
+// Output bits that are left clear
+const unsigned int BIT_PERMUTATION_NONE = 0xFFFFFFFFU;
+
+// Gathers up to 64 bits from a string of IN_BYTES bytes into a word, MSB
+// first, output bit i taken from input bit source[i]. The tables are built
+// at compile time from the source positions, after which a whole permutation
+// is one lookup per input byte, or one pext per run of rising source
+// positions where the CPU has BMI2.
+template<unsigned int IN_BYTES> class CBitPermutation {
+public:
+	constexpr CBitPermutation(const unsigned int* source, unsigned int length, unsigned int offset = 0U) :
+#if defined(CPU_DISPATCH_X86_64)
+	m_runs(0U),
+	m_mask(),
+	m_start(),
+	m_length(),
+#endif
+	m_table()
+	{
+		assert(source != NULL);
+		assert(length > 0U && length <= 64U);
+
+		for (unsigned int i = 0U; i < length; i++) {
+			if (source[i] == BIT_PERMUTATION_NONE)
+				continue;
+
+			unsigned int pos = source[i] + offset;
+			assert(pos < IN_BYTES * 8U);
+
+			uint64_t bit = uint64_t(1U) << (63U - i);
+			unsigned int mask = 0x80U >> (pos & 0x07U);
+
+			for (unsigned int v = 0U; v < 256U; v++) {
+				if ((v & mask) != 0U)
+					m_table[pos >> 3][v] |= bit;
+			}
+		}
+
+#if defined(CPU_DISPATCH_X86_64)
+		// Each run is a stretch of output bits whose sources rise, pext packs them in order
+		if (IN_BYTES <= 8U) {
+			unsigned int last = 0U;
+			for (unsigned int i = 0U; i < length; i++) {
+				if (source[i] == BIT_PERMUTATION_NONE)
+					continue;
+
+				unsigned int pos = source[i] + offset;
+				if (m_runs == 0U || pos <= last || m_start[m_runs - 1U] + m_length[m_runs - 1U] != i) {
+					m_mask[m_runs]   = 0U;
+					m_start[m_runs]  = i;
+					m_length[m_runs] = 0U;
+					m_runs++;
+				}
+
+				m_mask[m_runs - 1U] |= uint64_t(1U) << (63U - pos);
+				m_length[m_runs - 1U]++;
+				last = pos;
+			}
+		}
+#endif
+	}
+
+	uint64_t permute(const unsigned char* in) const
+	{
+		assert(in != NULL);
+
+#if defined(CPU_DISPATCH_X86_64)
+		if (IN_BYTES <= 8U && s_pext)
+			return permutePext(in);
+#endif
+
+		uint64_t out = 0U;
+		for (unsigned int n = 0U; n < IN_BYTES; n++)
+			out |= m_table[n][in[n]];
+
+		return out;
+	}
+
+	// Write the top length bits of a word into a string of bytes at any bit position
+	static void put(unsigned char* out, unsigned int pos, unsigned int length, uint64_t word)
+	{
+		assert(out != NULL);
+		assert(length > 0U && length <= 64U);
+
+		uint64_t mask = length == 64U ? ~uint64_t(0U) : ~(~uint64_t(0U) >> length);
+		word &= mask;
+
+		unsigned int first = pos >> 3;
+		unsigned int last  = (pos + length - 1U) >> 3;
+		unsigned int off   = pos & 0x07U;
+
+		out[first] = (out[first] & ~(unsigned char)(mask >> (56U + off))) | (unsigned char)(word >> (56U + off));
+
+		for (unsigned int n = first + 1U; n <= last; n++) {
+			unsigned int shift = (n - first) * 8U - off;
+			out[n] = (out[n] & ~(unsigned char)((mask << shift) >> 56)) | (unsigned char)((word << shift) >> 56);
+		}
+	}
+
+	static const char* getKernel()
+	{
+#if defined(CPU_DISPATCH_X86_64)
+		return CCPUFeatures::hasBMI2() ? "BMI2" : "table";
+#else
+		return "table";
+#endif
+	}
+
+private:
+#if defined(CPU_DISPATCH_X86_64)
+	CPU_TARGET("bmi2") uint64_t permutePext(const unsigned char* in) const
+	{
+		uint64_t word = 0U;
+		for (unsigned int n = 0U; n < IN_BYTES && n < 8U; n++)
+			word |= uint64_t(in[n]) << (56U - n * 8U);
+
+		uint64_t out = 0U;
+		for (unsigned int n = 0U; n < m_runs; n++)
+			out |= uint64_t(_pext_u64(word, m_mask[n])) << (64U - m_start[n] - m_length[n]);
+
+		return out;
+	}
+
+#endif
+#if defined(CPU_DISPATCH_X86_64)
+	// Set at startup, until then the tables are used
+	static const bool s_pext;
+
+	unsigned int m_runs;
+	uint64_t     m_mask[64U];
+	unsigned int m_start[64U];
+	unsigned int m_length[64U];
+#endif
+	uint64_t     m_table[IN_BYTES][256U];
+};
+
+#if defined(CPU_DISPATCH_X86_64)
+template<unsigned int IN_BYTES> const bool CBitPermutation<IN_BYTES>::s_pext = CCPUFeatures::hasBMI2();
+#endif
+
+#endif
@@ -0,0 +1,124 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#ifndef BitVector_H
+#define BitVector_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+// A fixed size string of bits held MSB first in 64 bit words, bit 0 is the
+// first bit on air. Fields of up to 32 bits are read and written with a
+// couple of shifts instead of one bool per bit.
+template<unsigned int N> class CBitVector {
+public:
+	CBitVector()
+	{
+		clear();
+	}
+
+	~CBitVector()
+	{
+	}
+
+	void clear()
+	{
+		for (unsigned int i = 0U; i < WORDS; i++)
+			m_words[i] = 0U;
+	}
+
+	bool getBit(unsigned int pos) const
+	{
+		assert(pos < N);
+
+		return ((m_words[pos >> 6] >> (63U - (pos & 0x3FU))) & 0x01U) == 0x01U;
+	}
+
+	void setBit(unsigned int pos, bool bit)
+	{
+		assert(pos < N);
+
+		uint64_t mask = uint64_t(1U) << (63U - (pos & 0x3FU));
+		if (bit)
+			m_words[pos >> 6] |= mask;
+		else
+			m_words[pos >> 6] &= ~mask;
+	}
+
+	unsigned int getField(unsigned int pos, unsigned int length) const
+	{
+		assert(length > 0U && length <= 32U);
+		assert(pos + length <= N);
+
+		unsigned int w   = pos >> 6;
+		unsigned int off = pos & 0x3FU;
+
+		uint64_t value = m_words[w] << off;
+		if (off + length > 64U)
+			value |= m_words[w + 1U] >> (64U - off);
+
+		return (unsigned int)(value >> (64U - length));
+	}
+
+	void setField(unsigned int pos, unsigned int length, unsigned int value)
+	{
+		assert(length > 0U && length <= 32U);
+		assert(pos + length <= N);
+
+		unsigned int w   = pos >> 6;
+		unsigned int end = (pos & 0x3FU) + length;
+
+		uint64_t mask = ~uint64_t(0U) >> (64U - length);
+		uint64_t v    = uint64_t(value) & mask;
+
+		if (end <= 64U) {
+			m_words[w] = (m_words[w] & ~(mask << (64U - end))) | (v << (64U - end));
+		} else {
+			end -= 64U;
+			m_words[w]      = (m_words[w]      & ~(mask >> end))         | (v >> end);
+			m_words[w + 1U] = (m_words[w + 1U] & ~(mask << (64U - end))) | (v << (64U - end));
+		}
+	}
+
+	void getBytes(unsigned char* bytes, unsigned int pos, unsigned int length) const
+	{
+		assert(bytes != NULL);
+		assert((length % 8U) == 0U);
+
+		for (unsigned int i = 0U; i < length; i += 8U)
+			*bytes++ = getField(pos + i, 8U);
+	}
+
+	void setBytes(const unsigned char* bytes, unsigned int pos, unsigned int length)
+	{
+		assert(bytes != NULL);
+		assert((length % 8U) == 0U);
+
+		for (unsigned int i = 0U; i < length; i += 8U)
+			setField(pos + i, 8U, *bytes++);
+	}
+
+private:
+	static const unsigned int WORDS = (N + 63U) / 64U;
+
+	uint64_t m_words[WORDS];
+};
+
+#endif
@@ -0,0 +1,788 @@
+/*
+*   Copyright (C) 2016,2017 by Jonathan Naylor G4KLX
+*   Copyright (C) 2018 by Andy Uribe CA6JAU
+*   Copyright (C) 2026 by agent
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "Bridge.h"
+#include "DMRLC.h"
+#include "DMRFullLC.h"
+#include "DMRBurst.h"
+#include "NXDNLICH.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cassert>
+
+#define DMR_FRAME_PER       60U
+#define NXDN_FRAME_PER      80U
+
+#define NXDNGW_DSTID_DEF    20U
+#define NXDN_RAN            0x01U
+
+#define XLX_SLOT            2U
+#define XLX_COLOR_CODE      3U
+
+// Defined by Version.h, which only the host includes
+extern const char* VERSION;
+
+CBridge::CBridge(const CConf& conf, const CBridgeConf& bridge, const std::string& name, CDMRLookup* dmrLookup, CNXDNLookup* nxdnLookup, CReflectors* reflectors) :
+m_conf(conf),
+m_bridge(bridge),
+m_prefix(),
+m_callsign(conf.getCallsign()),
+m_nxdnTG(bridge.m_tg),
+m_dmrNetwork(NULL),
+m_nxdnNetwork(NULL),
+m_dmrlookup(dmrLookup),
+m_nxdnlookup(nxdnLookup),
+m_conv(),
+m_colorcode(1U),
+m_srcHS(0U),
+m_defsrcid(0U),
+m_dstid(0U),
+m_dmrpc(false),
+m_nxdnRx(),
+m_dmrRx(),
+m_toDMR(),
+m_toNXDN(),
+m_dmrTemplate(),
+m_nxdnTemplate(),
+m_dmrflco(FLCO_GROUP),
+m_networkWatchdog(100U, 0U, 1500U),
+m_pollTimer(1000U, 5U),
+m_xlxmodule(),
+m_xlxConnected(false),
+m_xlxReflectors(reflectors),
+m_xlxrefl(0U),
+m_nxdnIn(128U, "NXDN RX", true),
+m_dmrIn(128U, "DMR RX", true),
+m_dmrOut(128U, "DMR encoder", true),
+m_nxdnOut(128U, "NXDN encoder", true),
+m_dmrTx(DMR_FRAME_PER, DMR_FRAME_PER, 100U, "DMR TX"),
+m_nxdnTx(NXDN_FRAME_PER, NXDN_FRAME_PER, 100U, "NXDN TX"),
+m_txReactor(NULL),
+m_dmrClock(-1),
+m_nxdnClock(-1)
+{
+	assert(dmrLookup != NULL);
+	assert(nxdnLookup != NULL);
+
+	// Only needed to tell the bridges apart when the host runs more than one
+	if (!name.empty())
+		m_prefix = name + ", ";
+
+	::memset(m_nxdnFrame, 0U, 200U);
+	::memset(m_dmrFrame, 0U, 50U);
+}
+
+CBridge::~CBridge()
+{
+	delete m_dmrNetwork;
+	delete m_nxdnNetwork;
+}
+
+bool CBridge::open(CReactor* nxdnReactor, CReactor* dmrReactor, CReactor* txReactor)
+{
+	assert(nxdnReactor != NULL);
+	assert(dmrReactor != NULL);
+	assert(txReactor != NULL);
+
+	bool debug               = m_conf.getDMRNetworkDebug();
+	in_addr dstAddress       = CUDPSocket::lookup(m_bridge.m_dstAddress);
+	unsigned int dstPort     = m_bridge.m_dstPort;
+	std::string localAddress = m_conf.getLocalAddress();
+	unsigned int localPort   = m_bridge.m_localPort;
+
+	m_nxdnNetwork = new CNXDNNetwork(localAddress, localPort, m_callsign, debug);
+	m_nxdnNetwork->setDestination(dstAddress, dstPort);
+	m_nxdnNetwork->setReactor(nxdnReactor);
+
+	bool ret = m_nxdnNetwork->open();
+	if (!ret) {
+		LogError("%sCannot open the NXDN network port", m_prefix.c_str());
+		return false;
+	}
+
+	ret = createDMRNetwork(dmrReactor);
+	if (!ret) {
+		LogError("%sCannot open DMR Network", m_prefix.c_str());
+		return false;
+	}
+
+	if (m_dmrpc)
+		m_dmrflco = FLCO_USER_USER;
+	else
+		m_dmrflco = FLCO_GROUP;
+
+	// Armed for the departure time of the next queued frame
+	m_txReactor = txReactor;
+	m_dmrClock  = txReactor->addTimer(DMR_FRAME_PER);
+	m_nxdnClock = txReactor->addTimer(NXDN_FRAME_PER);
+
+	m_pollTimer.start();
+
+	// Link to reflector at startup (not NXDNGateway operation)
+	if (m_nxdnTG != NXDNGW_DSTID_DEF) {
+		m_nxdnNetwork->writePoll(m_nxdnTG, 3U);
+	}
+
+	return true;
+}
+
+bool CBridge::isReceiving()
+{
+	return m_networkWatchdog.isRunning();
+}
+
+void CBridge::close()
+{
+	if (m_nxdnNetwork != NULL) {
+		// Unlink reflector at exit (not NXDNGateway operation)
+		if (m_nxdnTG != NXDNGW_DSTID_DEF) {
+			m_nxdnNetwork->writeUnlink(m_nxdnTG, 3U);
+		}
+
+		m_nxdnNetwork->close();
+	}
+
+	if (m_dmrNetwork != NULL)
+		m_dmrNetwork->close();
+}
+
+bool CBridge::readNXDN(unsigned int ms)
+{
+	unsigned char buffer[2000U];
+	bool queued = false;
+
+	unsigned int len = 0;
+	while ((len = m_nxdnNetwork->read(buffer)) > 0U) {
+		if (::memcmp(buffer, "NXDND", 5U) == 0U && len == 43U) {
+			CNXDNLICH lich;
+			m_nxdnRx.m_srcId = (buffer[5U] << 8) | buffer[6U];
+			m_nxdnRx.m_dstId = (buffer[7U] << 8) | buffer[8U];
+			bool end = (buffer[9U] & 0x08) == 0x08;
+			bool grp = (buffer[9U] & 0x01) == 0x01;
+
+			lich.setRaw(buffer[10U]);
+			unsigned char usc = lich.getFCT();
+			unsigned char opt = lich.getOption();
+
+			if (usc == NXDN_LICH_USC_SACCH_NS) {
+				if (end) {
+					LogMessage("%sNXDN received end of voice transmission, %.1f seconds", m_prefix.c_str(), float(m_nxdnRx.m_frames) / 12.5F);
+					queued |= writeIngress(m_nxdnIn, TAG_EOT, 0U, m_nxdnRx.m_frames, NULL);
+					m_nxdnRx.m_frames = 0U;
+					m_nxdnRx.m_info = false;
+				} else {
+					char netSrc[ID_CALLSIGN_LENGTH], netDst[ID_CALLSIGN_LENGTH];
+					m_nxdnlookup->findCS(m_nxdnRx.m_srcId, netSrc);
+					m_nxdnlookup->findCS(m_nxdnRx.m_dstId, netDst);
+					LogMessage("%sReceived NXDN header from %s to %s%s", m_prefix.c_str(), netSrc, grp ? "TG " : "", netDst);
+
+					queued |= writeIngress(m_nxdnIn, TAG_HEADER, findDMRID(m_nxdnRx.m_srcId), 0U, NULL);
+					m_nxdnRx.m_frames = 0U;
+					m_nxdnRx.m_info = true;
+				}
+			} else {
+				if (opt == NXDN_LICH_STEAL_NONE) {
+					if (!m_nxdnRx.m_info) {
+						char netSrc[ID_CALLSIGN_LENGTH], netDst[ID_CALLSIGN_LENGTH];
+						m_nxdnlookup->findCS(m_nxdnRx.m_srcId, netSrc);
+						m_nxdnlookup->findCS(m_nxdnRx.m_dstId, netDst);
+						LogMessage("%sReceived NXDN late entry from %s to %s%s", m_prefix.c_str(), netSrc, grp ? "TG " : "", netDst);
+						queued |= writeIngress(m_nxdnIn, TAG_HEADER, findDMRID(m_nxdnRx.m_srcId), 0U, NULL);
+						m_nxdnRx.m_info = true;
+					}
+
+					queued |= writeIngress(m_nxdnIn, TAG_DATA, 0U, 0U, buffer + 10U);
+					m_nxdnRx.m_frames++;
+				}
+			}
+		}
+		else if (::memcmp(buffer, "NXDNP", 5U) == 0 && len == 17U && m_nxdnTG == NXDNGW_DSTID_DEF) {
+				// Return the poll
+				m_nxdnNetwork->write(buffer, len);
+		}
+	}
+
+	m_pollTimer.clock(ms);
+	if (m_pollTimer.isRunning() && m_pollTimer.hasExpired() && m_nxdnTG != NXDNGW_DSTID_DEF) {
+		m_nxdnNetwork->writePoll(m_nxdnTG);
+		m_pollTimer.start();
+	}
+
+	return queued;
+}
+
+bool CBridge::readDMR(unsigned int ms)
+{
+	CDMRData tx_dmrdata;
+	bool queued = false;
+
+	if (m_dmrNetwork->isConnected() && !m_xlxmodule.empty() && !m_xlxConnected) {
+		writeXLXLink(m_defsrcid, m_dstid, m_dmrNetwork);
+		LogMessage("%sXLX, Linking to reflector XLX%03u, module %s", m_prefix.c_str(), m_xlxrefl, m_xlxmodule.c_str());
+		m_xlxConnected = true;
+	}
+
+	// The datagrams that woke the reactor go through the delay buffers now, not after the next wait
+	m_dmrNetwork->receive();
+	m_dmrNetwork->clock(ms);
+
+	while (m_dmrNetwork->read(tx_dmrdata) > 0U) {
+		m_dmrRx.m_srcId = tx_dmrdata.getSrcId();
+		m_dmrRx.m_dstId = tx_dmrdata.getDstId();
+		
+		FLCO netflco = tx_dmrdata.getFLCO();
+		unsigned char DataType = tx_dmrdata.getDataType();
+
+		if (!tx_dmrdata.isMissing()) {
+			m_networkWatchdog.start();
+
+			if(DataType == DT_TERMINATOR_WITH_LC) {
+				queued |= writeIngress(m_dmrIn, TAG_EOT, 0U, m_dmrRx.m_frames, NULL);
+				m_dmrNetwork->reset(2U);
+				m_networkWatchdog.stop();
+				m_dmrRx.m_frames = 0U;
+				m_dmrRx.m_info = false;
+			}
+
+			if((DataType == DT_VOICE_LC_HEADER) && (DataType != m_dmrRx.m_lastDT)) {
+				char netSrc[ID_CALLSIGN_LENGTH], netDst[ID_CALLSIGN_LENGTH];
+				m_dmrlookup->findCS(m_dmrRx.m_srcId, netSrc);
+				m_dmrlookup->findCS(m_dmrRx.m_dstId, netDst);
+
+				queued |= writeIngress(m_dmrIn, TAG_HEADER, findNXDNID(m_dmrRx.m_srcId), 0U, NULL);
+				LogMessage("%sDMR header received from %s to %s%s", m_prefix.c_str(), netSrc, netflco == FLCO_GROUP ? "TG " : "", netDst);
+
+				m_dmrRx.m_info = true;
+
+				m_dmrRx.m_frames = 0U;
+			}
+
+			if(DataType == DT_VOICE_SYNC || DataType == DT_VOICE) {
+				unsigned char dmr_frame[50];
+				tx_dmrdata.getData(dmr_frame);
+				queued |= writeIngress(m_dmrIn, TAG_DATA, 0U, 0U, dmr_frame); // Add DMR frame for NXDN conversion
+				m_dmrRx.m_frames++;
+			}
+		}
+		else {
+			if(DataType == DT_VOICE_SYNC || DataType == DT_VOICE) {
+				unsigned char dmr_frame[50];
+				tx_dmrdata.getData(dmr_frame);
+
+				if (!m_dmrRx.m_info) {
+					char netSrc[ID_CALLSIGN_LENGTH], netDst[ID_CALLSIGN_LENGTH];
+					m_dmrlookup->findCS(m_dmrRx.m_srcId, netSrc);
+					m_dmrlookup->findCS(m_dmrRx.m_dstId, netDst);
+
+					queued |= writeIngress(m_dmrIn, TAG_HEADER, findNXDNID(m_dmrRx.m_srcId), 0U, NULL);
+					LogMessage("%sDMR late entry from %s to %s%s", m_prefix.c_str(), netSrc, netflco == FLCO_GROUP ? "TG " : "", netDst);
+
+					m_dmrRx.m_info = true;
+				}
+
+				queued |= writeIngress(m_dmrIn, TAG_DATA, 0U, 0U, dmr_frame); // Add DMR frame for NXDN conversion
+				m_dmrRx.m_frames++;
+			}
+
+			m_networkWatchdog.clock(ms);
+			if (m_networkWatchdog.hasExpired()) {
+				LogDebug("%sNetwork watchdog has expired, %.1f seconds", m_prefix.c_str(), float(m_dmrRx.m_frames) / 16.667F);
+				m_dmrNetwork->reset(2U);
+				m_networkWatchdog.stop();
+				m_dmrRx.m_frames = 0U;
+				m_dmrRx.m_info = false;
+			}
+		}
+		
+		m_dmrRx.m_lastDT = DataType;
+	}
+
+	return queued;
+}
+
+bool CBridge::transcode()
+{
+	CIngressFrame frame;
+	bool queued = false;
+
+	// Encode after every frame, so a new header cannot change the ids of the call before it
+	while (m_nxdnIn.hasData()) {
+		m_nxdnIn.getData(&frame, 1U);
+
+		if (frame.m_tag == TAG_HEADER) {
+			m_toDMR.m_srcId = frame.m_srcId;
+			m_conv.putNXDNHeader();
+		} else if (frame.m_tag == TAG_DATA) {
+			m_conv.putNXDN(frame.m_data);
+		} else {
+			m_conv.putNXDNEOT();
+		}
+
+		queued |= encodeDMR();
+	}
+
+	while (m_dmrIn.hasData()) {
+		m_dmrIn.getData(&frame, 1U);
+
+		if (frame.m_tag == TAG_HEADER) {
+			m_toNXDN.m_srcId = frame.m_srcId;
+			m_conv.putDMRHeader();
+		} else if (frame.m_tag == TAG_DATA) {
+			m_conv.putDMR(frame.m_data);
+		} else {
+			unsigned int bits = m_conv.getDMRBits();
+			float ber = bits > 0U ? float(m_conv.getDMRErrors() * 100U) / float(bits) : 0.0F;
+			LogMessage("%sDMR received end of voice transmission, %.1f seconds, BER: %.1f%%", m_prefix.c_str(), float(frame.m_frames) / 16.667F, ber);
+
+			m_conv.putDMREOT();
+		}
+
+		queued |= encodeNXDN();
+	}
+
+	return queued;
+}
+
+bool CBridge::encodeDMR()
+{
+	bool queued = false;
+
+	unsigned int dmrFrameType;
+	while ((dmrFrameType = m_conv.getDMR(m_dmrFrame)) != TAG_NODATA) {
+		queued = true;
+
+		if(dmrFrameType == TAG_HEADER) {
+			m_toDMR.m_seqNo = 0U;
+
+			// Sync, SlotType and Full LC
+			m_dmrTemplate.setCall(m_toDMR.m_srcId, m_dstid, m_dmrflco, m_colorcode);
+			m_dmrTemplate.getHeader(m_dmrFrame);
+			
+			//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
+
+			for (unsigned int i = 0U; i < 3U; i++) {
+				writeDMR(DT_VOICE_LC_HEADER, 0U);
+				m_toDMR.m_seqNo++;
+			}
+		}
+		else if(dmrFrameType == TAG_EOT) {
+			unsigned int n_dmr = (m_toDMR.m_seqNo - 3U) % 6U;
+			unsigned int fill = (6U - n_dmr);
+			
+			if (n_dmr) {
+				for (unsigned int i = 0U; i < fill; i++) {
+					::memcpy(m_dmrFrame, DMR_SILENCE_DATA, DMR_FRAME_LENGTH_BYTES);
+
+					// The EMB and Embedded LC
+					m_dmrTemplate.getVoice(m_dmrFrame, n_dmr);
+
+					//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
+					writeDMR(DT_VOICE, n_dmr);
+
+					n_dmr++;
+					m_toDMR.m_seqNo++;
+				}
+			}
+
+			// Sync, SlotType and Full LC
+			m_dmrTemplate.setCall(m_toDMR.m_srcId, m_dstid, m_dmrflco, m_colorcode);
+			m_dmrTemplate.getTerminator(m_dmrFrame);
+
+			//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
+			writeDMR(DT_TERMINATOR_WITH_LC, n_dmr);
+		}
+		else if(dmrFrameType == TAG_DATA) {
+			unsigned int n_dmr = (m_toDMR.m_seqNo - 3U) % 6U;
+		
+			if (!n_dmr) {
+				// A late entry has not seen a header, so check the call at each superframe
+				m_dmrTemplate.setCall(m_toDMR.m_srcId, m_dstid, m_dmrflco, m_colorcode);
+
+				// Add sync
+				m_dmrTemplate.getVoice(m_dmrFrame, n_dmr);
+
+				writeDMR(DT_VOICE_SYNC, n_dmr);
+			}
+			else {
+				// The EMB and Embedded LC
+				m_dmrTemplate.getVoice(m_dmrFrame, n_dmr);
+
+				writeDMR(DT_VOICE, n_dmr);
+			}
+
+			//CUtils::dump(1U, "DMR data:", m_dmrFrame, 33U);
+
+			m_toDMR.m_seqNo++;
+		}
+	}
+
+	return queued;
+}
+
+bool CBridge::encodeNXDN()
+{
+	bool queued = false;
+
+	unsigned int nxdnFrameType;
+	while ((nxdnFrameType = m_conv.getNXDN(m_nxdnFrame)) != TAG_NODATA) {
+		queued = true;
+
+		// The frames are only encoded again when the source has changed
+		m_nxdnTemplate.setCall(m_toNXDN.m_srcId & 0xFFFF, m_nxdnTG & 0xFFFF, NXDN_RAN);
+
+		if(nxdnFrameType == TAG_HEADER) {
+			m_toNXDN.m_seqNo = 0U;
+
+			// LICH, SACCH and the VCALL in the FACCH1
+			m_nxdnTemplate.getHeader(m_nxdnFrame);
+
+			writeNXDN(false);
+		}
+		else if (nxdnFrameType == TAG_EOT) {
+			// LICH, SACCH and the TX_REL in the FACCH1
+			m_nxdnTemplate.getRelease(m_nxdnFrame);
+
+			writeNXDN(true);
+
+			m_toNXDN.m_seqNo = 0U;
+		}
+		else if (nxdnFrameType == TAG_DATA) {
+			// LICH and the VCALL fragment in the SACCH
+			m_nxdnTemplate.getVoice(m_nxdnFrame, m_toNXDN.m_seqNo);
+
+			// Send data to MMDVMHost
+			writeNXDN(false);
+			
+			m_toNXDN.m_seqNo++;
+		}
+	}
+
+	return queued;
+}
+
+void CBridge::transmit()
+{
+	CDMRFrame dmrFrame;
+	while (m_dmrOut.hasData()) {
+		m_dmrOut.getData(&dmrFrame, 1U);
+		m_dmrTx.add(dmrFrame);
+
+		// The next call starts its own departure grid
+		if (dmrFrame.m_dataType == DT_TERMINATOR_WITH_LC)
+			m_dmrTx.reset();
+	}
+
+	m_txReactor->hasExpired(m_dmrClock);
+
+	while (m_dmrTx.get(dmrFrame)) {
+		CDMRData dmrdata;
+		dmrdata.setSlotNo(2U);
+		dmrdata.setSrcId(dmrFrame.m_srcId);
+		dmrdata.setDstId(dmrFrame.m_dstId);
+		dmrdata.setFLCO(dmrFrame.m_flco);
+		dmrdata.setN(dmrFrame.m_n);
+		dmrdata.setSeqNo(dmrFrame.m_seqNo);
+		dmrdata.setBER(0U);
+		dmrdata.setRSSI(0U);
+		dmrdata.setDataType(dmrFrame.m_dataType);
+		dmrdata.setData(dmrFrame.m_data);
+
+		m_dmrNetwork->write(dmrdata);
+
+		if (dmrFrame.m_dataType == DT_TERMINATOR_WITH_LC) {
+			LogMessage("%sDMR sent end of voice transmission, %u frames, %u deadline misses", m_prefix.c_str(), m_dmrTx.getFrames(), m_dmrTx.getMisses());
+			m_dmrTx.clearStats();
+		}
+	}
+
+	if (m_dmrTx.hasDeadline())
+		m_txReactor->startTimer(m_dmrClock, m_dmrTx.getDeadline());
+	else
+		m_txReactor->stopTimer(m_dmrClock);
+
+	CNXDNFrame nxdnFrame;
+	while (m_nxdnOut.hasData()) {
+		m_nxdnOut.getData(&nxdnFrame, 1U);
+		m_nxdnTx.add(nxdnFrame);
+
+		if (nxdnFrame.m_end)
+			m_nxdnTx.reset();
+	}
+
+	m_txReactor->hasExpired(m_nxdnClock);
+
+	while (m_nxdnTx.get(nxdnFrame)) {
+		m_nxdnNetwork->write(nxdnFrame.m_data, nxdnFrame.m_srcId, nxdnFrame.m_dstId, true);
+
+		if (nxdnFrame.m_end) {
+			LogMessage("%sNXDN sent end of voice transmission, %u frames, %u deadline misses", m_prefix.c_str(), m_nxdnTx.getFrames(), m_nxdnTx.getMisses());
+			m_nxdnTx.clearStats();
+		}
+	}
+
+	if (m_nxdnTx.hasDeadline())
+		m_txReactor->startTimer(m_nxdnClock, m_nxdnTx.getDeadline());
+	else
+		m_txReactor->stopTimer(m_nxdnClock);
+}
+
+bool CBridge::writeIngress(CRingBuffer<CIngressFrame>& queue, unsigned char tag, unsigned int srcId, unsigned int frames, const unsigned char* data)
+{
+	CIngressFrame frame;
+	frame.m_tag    = tag;
+	frame.m_srcId  = srcId;
+	frame.m_frames = frames;
+
+	if (data != NULL)
+		::memcpy(frame.m_data, data, 33U);
+	else
+		::memset(frame.m_data, 0x00U, 33U);
+
+	return queue.addData(&frame, 1U);
+}
+
+bool CBridge::writeDMR(unsigned char dataType, unsigned char n)
+{
+	CDMRFrame frame;
+	::memcpy(frame.m_data, m_dmrFrame, DMR_FRAME_LENGTH_BYTES);
+	frame.m_srcId    = m_toDMR.m_srcId;
+	frame.m_dstId    = m_dstid;
+	frame.m_flco     = m_dmrflco;
+	frame.m_dataType = dataType;
+	frame.m_seqNo    = m_toDMR.m_seqNo;
+	frame.m_n        = n;
+
+	return m_dmrOut.addData(&frame, 1U);
+}
+
+bool CBridge::writeNXDN(bool end)
+{
+	CNXDNFrame frame;
+	::memcpy(frame.m_data, m_nxdnFrame, 33U);
+	frame.m_srcId = m_toNXDN.m_srcId;
+	frame.m_dstId = m_nxdnTG;
+	frame.m_end   = end;
+
+	return m_nxdnOut.addData(&frame, 1U);
+}
+
+unsigned int CBridge::findNXDNID(unsigned int dmrid)
+{
+	char dmrCS[ID_CALLSIGN_LENGTH];
+	m_dmrlookup->findCS(dmrid, dmrCS);
+	unsigned int nxdnID = m_nxdnlookup->findID(dmrCS);
+
+	if (nxdnID == 0)
+		nxdnID = truncID(dmrid);
+	else
+		LogMessage("%sNXDN ID of %s: %u", m_prefix.c_str(), dmrCS, nxdnID);
+
+	return nxdnID;
+}
+
+unsigned int CBridge::findDMRID(unsigned int nxdnid)
+{
+	char nxdnCS[ID_CALLSIGN_LENGTH];
+	m_nxdnlookup->findCS(nxdnid, nxdnCS);
+	unsigned int dmrID = m_dmrlookup->findID(nxdnCS);
+
+	if (dmrID == 0)
+		dmrID = m_defsrcid;
+	else
+		LogMessage("%sDMR ID of %s: %u", m_prefix.c_str(), nxdnCS, dmrID);
+
+	return dmrID;
+}
+
+unsigned int CBridge::truncID(unsigned int id)
+{
+	char temp[20];
+
+	snprintf(temp, 8, "%07d", id);
+	unsigned int newid = atoi(temp + 2);
+
+	if (newid > 65519)
+		newid = 65519;
+
+	if (newid == 0)
+		newid = 1;
+
+	return newid;
+}
+
+bool CBridge::createDMRNetwork(CReactor* reactor)
+{
+	std::string address   = m_bridge.m_dmrNetworkAddress;
+	m_xlxmodule           = m_bridge.m_dmrXLXModule;
+	m_xlxrefl             = m_bridge.m_dmrXLXReflector;
+	unsigned int port     = m_bridge.m_dmrNetworkPort;
+	unsigned int local    = m_bridge.m_dmrNetworkLocal;
+	std::string password  = m_bridge.m_dmrNetworkPassword;
+	bool debug            = m_conf.getDMRNetworkDebug();
+	unsigned int jitter   = m_conf.getDMRNetworkJitter();
+	bool slot1            = false;
+	bool slot2            = true;
+	bool duplex           = false;
+	HW_TYPE hwType        = HWT_MMDVM;
+
+	m_srcHS = m_bridge.m_dmrId;
+	m_colorcode = 1U;
+
+	if (m_xlxmodule.empty()) {
+		m_dstid = m_bridge.m_dmrDstId;
+		m_dmrpc = m_bridge.m_dmrPC;
+	}
+	else {
+		const char *xlxmod = m_xlxmodule.c_str();
+		m_dstid = 4000 + xlxmod[0] - 64;
+		m_dmrpc = 0;
+
+		if (m_xlxReflectors == NULL)
+			return false;
+
+		CReflector* reflector = m_xlxReflectors->find(m_xlxrefl);
+		if (reflector == NULL)
+			return false;
+		
+		address = reflector->m_address;
+	}
+
+	if (m_srcHS > 99999999U)
+		m_defsrcid = m_srcHS / 100U;
+	else if (m_srcHS > 9999999U)
+		m_defsrcid = m_srcHS / 10U;
+	else
+		m_defsrcid = m_srcHS;
+	
+	LogMessage("%sDMR Network Parameters", m_prefix.c_str());
+	LogMessage("    ID: %u", m_srcHS);
+	LogMessage("    Default SrcID: %u", m_defsrcid);
+	if (!m_xlxmodule.empty()) {
+		LogMessage("    XLX Reflector: %d", m_xlxrefl);
+		LogMessage("    XLX Module: %s (%d)", m_xlxmodule.c_str(), m_dstid);
+	}
+	else {
+		LogMessage("    Startup DstID: %s%u", m_dmrpc ? "" : "TG ", m_dstid);
+		LogMessage("    Address: %s", address.c_str());
+	}
+	LogMessage("    Port: %u", port);
+	if (local > 0U)
+		LogMessage("    Local: %u", local);
+	else
+		LogMessage("    Local: random");
+	LogMessage("    Jitter: %ums", jitter);
+
+	m_dmrNetwork = new CDMRNetwork(address, port, local, m_srcHS, password, duplex, VERSION, debug, slot1, slot2, hwType, jitter);
+
+	std::string options = m_conf.getDMRNetworkOptions();
+	if (!options.empty()) {
+		LogMessage("    Options: %s", options.c_str());
+		m_dmrNetwork->setOptions(options);
+	}
+
+	unsigned int rxFrequency = m_conf.getRxFrequency();
+	unsigned int txFrequency = m_conf.getTxFrequency();
+	unsigned int power       = m_conf.getPower();
+	float latitude           = m_conf.getLatitude();
+	float longitude          = m_conf.getLongitude();
+	int height               = m_conf.getHeight();
+	std::string location     = m_conf.getLocation();
+	std::string description  = m_conf.getDescription();
+	std::string url          = m_conf.getURL();
+
+	LogMessage("%sInfo Parameters", m_prefix.c_str());
+	LogMessage("    Callsign: %s", m_callsign.c_str());
+	LogMessage("    RX Frequency: %uHz", rxFrequency);
+	LogMessage("    TX Frequency: %uHz", txFrequency);
+	LogMessage("    Power: %uW", power);
+	LogMessage("    Latitude: %fdeg N", latitude);
+	LogMessage("    Longitude: %fdeg E", longitude);
+	LogMessage("    Height: %um", height);
+	LogMessage("    Location: \"%s\"", location.c_str());
+	LogMessage("    Description: \"%s\"", description.c_str());
+	LogMessage("    URL: \"%s\"", url.c_str());
+
+	m_dmrNetwork->setConfig(m_callsign, rxFrequency, txFrequency, power, m_colorcode, latitude, longitude, height, location, description, url);
+	m_dmrNetwork->setReactor(reactor);
+
+	bool ret = m_dmrNetwork->open();
+	if (!ret) {
+		delete m_dmrNetwork;
+		m_dmrNetwork = NULL;
+		return false;
+	}
+
+	m_dmrNetwork->enable(true);
+
+	return true;
+}
+
+void CBridge::writeXLXLink(unsigned int srcId, unsigned int dstId, CDMRNetwork* network)
+{
+	assert(network != NULL);
+
+	unsigned int streamId = ::rand() + 1U;
+
+	CDMRData data;
+
+	data.setSlotNo(XLX_SLOT);
+	data.setFLCO(FLCO_USER_USER);
+	data.setSrcId(srcId);
+	data.setDstId(dstId);
+	data.setDataType(DT_VOICE_LC_HEADER);
+	data.setN(0U);
+	data.setStreamId(streamId);
+
+	unsigned char buffer[DMR_FRAME_LENGTH_BYTES];
+
+	CDMRLC lc;
+	lc.setSrcId(srcId);
+	lc.setDstId(dstId);
+	lc.setFLCO(FLCO_USER_USER);
+
+	CDMRFullLC fullLC;
+	fullLC.encode(lc, buffer, DT_VOICE_LC_HEADER);
+
+	CDMRBurst::addDataSync(buffer, true, XLX_COLOR_CODE, DT_VOICE_LC_HEADER);
+
+	data.setData(buffer);
+
+	for (unsigned int i = 0U; i < 3U; i++) {
+		data.setSeqNo(i);
+		network->write(data);
+	}
+
+	data.setDataType(DT_TERMINATOR_WITH_LC);
+
+	fullLC.encode(lc, buffer, DT_TERMINATOR_WITH_LC);
+
+	CDMRBurst::addSlotType(buffer, XLX_COLOR_CODE, DT_TERMINATOR_WITH_LC);
+
+	data.setData(buffer);
+
+	for (unsigned int i = 0U; i < 2U; i++) {
+		data.setSeqNo(i + 3U);
+		network->write(data);
+	}
+}
+
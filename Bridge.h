@@ -0,0 +1,176 @@
+/*
+*   Copyright (C) 2016 by Jonathan Naylor G4KLX
+*   Copyright (C) 2018 by Andy Uribe CA6JAU
+*   Copyright (C) 2026 by agent
+*
+*   This program is free software; you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation; either version 2 of the License, or
+*   (at your option) any later version.
+*
+*   This program is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with this program; if not, write to the Free Software
+*   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#if !defined(BRIDGE_H)
+#define BRIDGE_H
+
+#include "DMRDefines.h"
+#include "NXDNDefines.h"
+#include "ModeConv.h"
+#include "DMRNetwork.h"
+#include "DMRCallTemplate.h"
+#include "NXDNCallTemplate.h"
+#include "DMRLookup.h"
+#include "NXDNLookup.h"
+#include "NXDNNetwork.h"
+#include "FrameScheduler.h"
+#include "RingBuffer.h"
+#include "Reflectors.h"
+#include "Reactor.h"
+#include "Timer.h"
+#include "Conf.h"
+
+#include <string>
+
+// The frames handed from one stage of the bridge to the next are plain data,
+// so they can be copied through an SPSC CRingBuffer
+class CIngressFrame {
+public:
+	unsigned char m_tag;
+	unsigned int  m_srcId;		// Header, the source id in the other mode
+	unsigned int  m_frames;		// EOT, the length of the call
+	unsigned char m_data[33U];
+};
+
+class CDMRFrame {
+public:
+	unsigned char m_data[33U];
+	unsigned int  m_srcId;
+	unsigned int  m_dstId;
+	FLCO          m_flco;
+	unsigned char m_dataType;
+	unsigned char m_seqNo;
+	unsigned char m_n;
+};
+
+class CNXDNFrame {
+public:
+	unsigned char  m_data[33U];
+	unsigned short m_srcId;
+	unsigned short m_dstId;
+	bool           m_end;
+};
+
+// A call being received from one network, only used by its receive stage
+class CRxCall {
+public:
+	CRxCall() :
+	m_srcId(0U),
+	m_dstId(0U),
+	m_frames(0U),
+	m_info(false),
+	m_lastDT(0U)
+	{
+	}
+
+	unsigned int  m_srcId;
+	unsigned int  m_dstId;
+	unsigned int  m_frames;
+	bool          m_info;
+	unsigned char m_lastDT;
+};
+
+// A call being generated for one network, only used by the transcode stage
+class CTxCall {
+public:
+	CTxCall() :
+	m_srcId(0U),
+	m_seqNo(0U)
+	{
+	}
+
+	unsigned int  m_srcId;
+	unsigned char m_seqNo;
+};
+
+// One NXDN talk group bridged to one DMR destination. The id lookups and the
+// XLX reflector list belong to the host and may be shared between bridges.
+// The four stages may be called from the same thread, or each from its own.
+class CBridge {
+public:
+	CBridge(const CConf& conf, const CBridgeConf& bridge, const std::string& name, CDMRLookup* dmrLookup, CNXDNLookup* nxdnLookup, CReflectors* reflectors);
+	~CBridge();
+
+	bool open(CReactor* nxdnReactor, CReactor* dmrReactor, CReactor* txReactor);
+
+	bool readNXDN(unsigned int ms);
+	bool readDMR(unsigned int ms);
+	bool transcode();
+	void transmit();
+
+	// While a DMR stream is being received the delay buffer needs clocking often
+	bool isReceiving();
+
+	void close();
+
+private:
+	const CConf&     m_conf;
+	CBridgeConf      m_bridge;
+	std::string      m_prefix;
+	std::string      m_callsign;
+	unsigned int     m_nxdnTG;
+	CDMRNetwork*     m_dmrNetwork;
+	CNXDNNetwork*    m_nxdnNetwork;
+	CDMRLookup*      m_dmrlookup;
+	CNXDNLookup*     m_nxdnlookup;
+	CModeConv        m_conv;
+	unsigned int     m_colorcode;
+	unsigned int     m_srcHS;
+	unsigned int     m_defsrcid;
+	unsigned int     m_dstid;
+	bool             m_dmrpc;
+	CRxCall          m_nxdnRx;
+	CRxCall          m_dmrRx;
+	CTxCall          m_toDMR;
+	CTxCall          m_toNXDN;
+	unsigned char    m_nxdnFrame[200U];
+	unsigned char    m_dmrFrame[50U];
+	CDMRCallTemplate m_dmrTemplate;
+	CNXDNCallTemplate m_nxdnTemplate;
+	FLCO             m_dmrflco;
+	CTimer           m_networkWatchdog;
+	CTimer           m_pollTimer;
+	std::string      m_xlxmodule;
+	bool             m_xlxConnected;
+	CReflectors*     m_xlxReflectors;
+	unsigned int     m_xlxrefl;
+	CRingBuffer<CIngressFrame>  m_nxdnIn;
+	CRingBuffer<CIngressFrame>  m_dmrIn;
+	CRingBuffer<CDMRFrame>      m_dmrOut;
+	CRingBuffer<CNXDNFrame>     m_nxdnOut;
+	CFrameScheduler<CDMRFrame>  m_dmrTx;
+	CFrameScheduler<CNXDNFrame> m_nxdnTx;
+	CReactor*        m_txReactor;
+	int              m_dmrClock;
+	int              m_nxdnClock;
+
+	bool encodeDMR();
+	bool encodeNXDN();
+	bool writeIngress(CRingBuffer<CIngressFrame>& queue, unsigned char tag, unsigned int srcId, unsigned int frames, const unsigned char* data);
+	bool writeDMR(unsigned char dataType, unsigned char n);
+	bool writeNXDN(bool end);
+	bool createDMRNetwork(CReactor* reactor);
+	unsigned int findNXDNID(unsigned int dmrid);
+	unsigned int findDMRID(unsigned int nxdnid);
+	unsigned int truncID(unsigned int id);
+	void writeXLXLink(unsigned int srcId, unsigned int dstId, CDMRNetwork* network);
+};
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "CPUFeatures.h"
+#include "Log.h"
+
+#include <cstdlib>
+#include <string>
+
+#if defined(__linux__) && defined(__arm__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+// Whether an extension is named in a comma separated list, or the list is "all"
+static bool isListed(const std::string& list, const std::string& name)
+{
+	std::string::size_type start = 0U;
+
+	while (start <= list.size()) {
+		std::string::size_type end = list.find(',', start);
+		if (end == std::string::npos)
+			end = list.size();
+
+		std::string item = list.substr(start, end - start);
+		if (item == name || item == "all")
+			return true;
+
+		start = end + 1U;
+	}
+
+	return false;
+}
+
+struct CPUFeatureSet {
+	CPUFeatureSet() :
+	m_sse2(false),
+	m_popcnt(false),
+	m_bmi2(false),
+	m_neon(false)
+	{
+#if defined(CPU_DISPATCH_X86_64)
+		__builtin_cpu_init();
+		m_sse2   = __builtin_cpu_supports("sse2") != 0;
+		m_popcnt = __builtin_cpu_supports("popcnt") != 0;
+		m_bmi2   = __builtin_cpu_supports("bmi2") != 0;
+#elif defined(__SSE2__)
+		m_sse2   = true;
+#endif
+
+#if defined(__aarch64__) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+		m_neon   = true;
+#elif defined(__linux__) && defined(__arm__)
+		m_neon   = (::getauxval(AT_HWCAP) & HWCAP_NEON) != 0UL;
+#endif
+
+		// NXDN2DMR_CPU_DISABLE=bmi2,neon or =all runs the fallback kernels, for the tests and benchmarks
+		const char* disable = ::getenv("NXDN2DMR_CPU_DISABLE");
+		if (disable != NULL) {
+			m_sse2   = m_sse2   && !isListed(disable, "sse2");
+			m_popcnt = m_popcnt && !isListed(disable, "popcnt");
+			m_bmi2   = m_bmi2   && !isListed(disable, "bmi2");
+			m_neon   = m_neon   && !isListed(disable, "neon");
+		}
+	}
+
+	bool m_sse2;
+	bool m_popcnt;
+	bool m_bmi2;
+	bool m_neon;
+};
+
+static const CPUFeatureSet& features()
+{
+	static const CPUFeatureSet set;
+
+	return set;
+}
+
+bool CCPUFeatures::hasSSE2()
+{
+	return features().m_sse2;
+}
+
+bool CCPUFeatures::hasPOPCNT()
+{
+	return features().m_popcnt;
+}
+
+bool CCPUFeatures::hasBMI2()
+{
+	return features().m_bmi2;
+}
+
+bool CCPUFeatures::hasNEON()
+{
+	return features().m_neon;
+}
+
+void CCPUFeatures::log()
+{
+	std::string text;
+
+	if (hasSSE2())
+		text += " SSE2";
+	if (hasPOPCNT())
+		text += " POPCNT";
+	if (hasBMI2())
+		text += " BMI2";
+	if (hasNEON())
+		text += " NEON";
+
+	LogInfo("CPU features:%s", text.empty() ? " none" : text.c_str());
+}
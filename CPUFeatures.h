@@ -0,0 +1,45 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(CPUFEATURES_H)
+#define	CPUFEATURES_H
+
+// Kernels with a variant for an instruction set extension outside the
+// compiler target are built with a target attribute and picked at startup.
+// On 32 bit ARM that takes GCC 8 or later, whose arm_neon.h can be used
+// from functions built for "fpu=neon" in a VFP only target.
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define	CPU_DISPATCH_X86_64
+#define	CPU_TARGET(isa)	__attribute__((target(isa)))
+#elif defined(__GNUC__) && defined(__linux__) && defined(__arm__) && defined(__ARM_FP) && !defined(__ARM_NEON)
+#define	CPU_DISPATCH_ARM
+#define	CPU_TARGET(isa)	__attribute__((target(isa)))
+#endif
+
+class CCPUFeatures {
+public:
+	static bool hasSSE2();
+	static bool hasPOPCNT();
+	static bool hasBMI2();
+	static bool hasNEON();
+
+	static void log();
+};
+
+#endif
@@ -19,7 +19,6 @@
 
 #include "CRC.h"
 
-#include "Utils.h"
 #include "Log.h"
 
 #include <cstdint>
@@ -120,7 +119,7 @@ const uint16_t CCITT16_TABLE2[] = {
 	0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0 };
 
 
-bool CCRC::checkFiveBit(bool* in, unsigned int tcrc)
+bool CCRC::checkFiveBit(const unsigned char* in, unsigned int tcrc)
 {
 	assert(in != NULL);
 
@@ -130,16 +129,13 @@ bool CCRC::checkFiveBit(bool* in, unsigned int tcrc)
 	return crc == tcrc;
 }
 
-void CCRC::encodeFiveBit(const bool* in, unsigned int& tcrc)
+void CCRC::encodeFiveBit(const unsigned char* in, unsigned int& tcrc)
 {
 	assert(in != NULL);
 
 	unsigned short total = 0U;
-	for (unsigned int i = 0U; i < 72U; i += 8U) {
-		unsigned char c;
-		CUtils::bitsToByteBE(in + i, c);
-		total += c;
-	}
+	for (unsigned int i = 0U; i < 9U; i++)
+		total += in[i];
 
 	total %= 31U;
 
@@ -34,7 +34,8 @@ enum SECTION {
   SECTION_DMR_NETWORK,
   SECTION_DMRID_LOOKUP,
   SECTION_NXDNID_LOOKUP,
-  SECTION_LOG
+  SECTION_LOG,
+  SECTION_BRIDGE
 };
 
 CConf::CConf(const std::string& file) :
@@ -46,6 +47,8 @@ m_dstPort(0U),
 m_localAddress(),
 m_localPort(0U),
 m_daemon(false),
+m_threaded(false),
+m_workers(0U),
 m_rxFrequency(0U),
 m_txFrequency(0U),
 m_power(0U),
@@ -70,13 +73,17 @@ m_dmrNetworkDebug(false),
 m_dmrNetworkJitterEnabled(true),
 m_dmrNetworkJitter(500U),
 m_dmrIdLookupFile(),
+m_dmrIdLookupIndex(),
 m_dmrIdLookupTime(0U),
 m_nxdnIdLookupFile(),
+m_nxdnIdLookupIndex(),
 m_nxdnIdLookupTime(0U),
 m_logDisplayLevel(0U),
 m_logFileLevel(0U),
 m_logFilePath(),
-m_logFileRoot()
+m_logFileRoot(),
+m_bridgeKeys(),
+m_bridges()
 {
 }
 
@@ -113,7 +120,10 @@ bool CConf::read()
 				section = SECTION_NXDNID_LOOKUP;
 			else if (::strncmp(buffer, "[Log]", 5U) == 0)
 				section = SECTION_LOG;
-			else
+			else if (::strncmp(buffer, "[Bridge]", 8U) == 0) {
+				section = SECTION_BRIDGE;
+				m_bridgeKeys.push_back(std::vector< std::pair<std::string, std::string> >());
+			} else
 				section = SECTION_NONE;
 
 			continue;
@@ -152,6 +162,10 @@ bool CConf::read()
 				m_localPort = (unsigned int)::atoi(value);
 			else if (::strcmp(key, "Daemon") == 0)
 				m_daemon = ::atoi(value) == 1;
+			else if (::strcmp(key, "Threaded") == 0)
+				m_threaded = ::atoi(value) == 1;
+			else if (::strcmp(key, "Workers") == 0)
+				m_workers = (unsigned int)::atoi(value);
 		} else if (section == SECTION_INFO) {
 			if (::strcmp(key, "TXFrequency") == 0)
 				m_txFrequency = (unsigned int)::atoi(value);
@@ -206,11 +220,15 @@ bool CConf::read()
 		} else if (section == SECTION_DMRID_LOOKUP) {
 			if (::strcmp(key, "File") == 0)
 				m_dmrIdLookupFile = value;
+			else if (::strcmp(key, "Index") == 0)
+				m_dmrIdLookupIndex = value;
 			else if (::strcmp(key, "Time") == 0)
 				m_dmrIdLookupTime = (unsigned int)::atoi(value);
 		} else if (section == SECTION_NXDNID_LOOKUP) {
 			if (::strcmp(key, "File") == 0)
 				m_nxdnIdLookupFile = value;
+			else if (::strcmp(key, "Index") == 0)
+				m_nxdnIdLookupIndex = value;
 			else if (::strcmp(key, "Time") == 0)
 				m_nxdnIdLookupTime = (unsigned int)::atoi(value);
 		} else if (section == SECTION_LOG) {
@@ -222,14 +240,81 @@ bool CConf::read()
 				m_logFileLevel = (unsigned int)::atoi(value);
 			else if (::strcmp(key, "DisplayLevel") == 0)
 				m_logDisplayLevel = (unsigned int)::atoi(value);
+		} else if (section == SECTION_BRIDGE) {
+			// Applied once the whole file is read, the main sections may come later
+			m_bridgeKeys.back().push_back(std::make_pair(std::string(key), std::string(value)));
 		}
 	}
 
 	::fclose(fp);
 
+	readBridges();
+
 	return true;
 }
 
+void CConf::readBridges()
+{
+	CBridgeConf bridge;
+	bridge.m_tg                 = m_tg;
+	bridge.m_dstAddress         = m_dstAddress;
+	bridge.m_dstPort            = m_dstPort;
+	bridge.m_localPort          = m_localPort;
+	bridge.m_dmrId              = m_dmrId;
+	bridge.m_dmrXLXModule       = m_dmrXLXModule;
+	bridge.m_dmrXLXReflector    = m_dmrXLXReflector;
+	bridge.m_dmrDstId           = m_dmrDstId;
+	bridge.m_dmrPC              = m_dmrPC;
+	bridge.m_dmrNetworkAddress  = m_dmrNetworkAddress;
+	bridge.m_dmrNetworkPort     = m_dmrNetworkPort;
+	bridge.m_dmrNetworkLocal    = m_dmrNetworkLocal;
+	bridge.m_dmrNetworkPassword = m_dmrNetworkPassword;
+
+	m_bridges.clear();
+	m_bridges.push_back(bridge);
+
+	for (unsigned int i = 0U; i < m_bridgeKeys.size(); i++) {
+		CBridgeConf conf = bridge;
+
+		for (unsigned int j = 0U; j < m_bridgeKeys.at(i).size(); j++) {
+			const char* key   = m_bridgeKeys.at(i).at(j).first.c_str();
+			const char* value = m_bridgeKeys.at(i).at(j).second.c_str();
+
+			if (::strcmp(key, "TG") == 0)
+				conf.m_tg = (unsigned int)::atoi(value);
+			else if (::strcmp(key, "DstAddress") == 0)
+				conf.m_dstAddress = value;
+			else if (::strcmp(key, "DstPort") == 0)
+				conf.m_dstPort = (unsigned int)::atoi(value);
+			else if (::strcmp(key, "LocalPort") == 0)
+				conf.m_localPort = (unsigned int)::atoi(value);
+			else if (::strcmp(key, "Id") == 0)
+				conf.m_dmrId = (unsigned int)::atoi(value);
+			else if (::strcmp(key, "XLXModule") == 0) {
+				conf.m_dmrXLXModule = value;
+				for (unsigned int k = 0U; k < conf.m_dmrXLXModule.size(); k++)
+					conf.m_dmrXLXModule[k] = ::toupper(conf.m_dmrXLXModule[k]);
+			}
+			else if (::strcmp(key, "XLXReflector") == 0)
+				conf.m_dmrXLXReflector = (unsigned int)::atoi(value);
+			else if (::strcmp(key, "StartupDstId") == 0)
+				conf.m_dmrDstId = (unsigned int)::atoi(value);
+			else if (::strcmp(key, "StartupPC") == 0)
+				conf.m_dmrPC = ::atoi(value) == 1;
+			else if (::strcmp(key, "Address") == 0)
+				conf.m_dmrNetworkAddress = value;
+			else if (::strcmp(key, "Port") == 0)
+				conf.m_dmrNetworkPort = (unsigned int)::atoi(value);
+			else if (::strcmp(key, "Local") == 0)
+				conf.m_dmrNetworkLocal = (unsigned int)::atoi(value);
+			else if (::strcmp(key, "Password") == 0)
+				conf.m_dmrNetworkPassword = value;
+		}
+
+		m_bridges.push_back(conf);
+	}
+}
+
 std::string CConf::getCallsign() const
 {
 	return m_callsign;
@@ -265,6 +350,16 @@ bool CConf::getDaemon() const
 	return m_daemon;
 }
 
+bool CConf::getThreaded() const
+{
+	return m_threaded;
+}
+
+unsigned int CConf::getWorkers() const
+{
+	return m_workers;
+}
+
 unsigned int CConf::getRxFrequency() const
 {
 	return m_rxFrequency;
@@ -385,6 +480,11 @@ std::string CConf::getDMRIdLookupFile() const
 	return m_dmrIdLookupFile;
 }
 
+std::string CConf::getDMRIdLookupIndex() const
+{
+	return m_dmrIdLookupIndex;
+}
+
 unsigned int CConf::getDMRIdLookupTime() const
 {
 	return m_dmrIdLookupTime;
@@ -395,6 +495,11 @@ std::string CConf::getNXDNIdLookupFile() const
 	return m_nxdnIdLookupFile;
 }
 
+std::string CConf::getNXDNIdLookupIndex() const
+{
+	return m_nxdnIdLookupIndex;
+}
+
 unsigned int CConf::getNXDNIdLookupTime() const
 {
 	return m_nxdnIdLookupTime;
@@ -419,3 +524,8 @@ std::string CConf::getLogFileRoot() const
 {
   return m_logFileRoot;
 }
+
+const std::vector<CBridgeConf>& CConf::getBridges() const
+{
+	return m_bridges;
+}
@@ -22,6 +22,27 @@
 
 #include <string>
 #include <vector>
+#include <utility>
+
+// The per bridge settings, the first bridge comes from the NXDN Network and
+// DMR Network sections, every [Bridge] section adds another one that starts
+// from the same values
+class CBridgeConf {
+public:
+  unsigned int m_tg;
+  std::string  m_dstAddress;
+  unsigned int m_dstPort;
+  unsigned int m_localPort;
+  unsigned int m_dmrId;
+  std::string  m_dmrXLXModule;
+  unsigned int m_dmrXLXReflector;
+  unsigned int m_dmrDstId;
+  bool         m_dmrPC;
+  std::string  m_dmrNetworkAddress;
+  unsigned int m_dmrNetworkPort;
+  unsigned int m_dmrNetworkLocal;
+  std::string  m_dmrNetworkPassword;
+};
 
 class CConf
 {
@@ -39,6 +60,8 @@ public:
   std::string  getLocalAddress() const;
   unsigned int getLocalPort() const;
   bool         getDaemon() const;
+  bool         getThreaded() const;
+  unsigned int getWorkers() const;
 
   // The Info section
   unsigned int getRxFrequency() const;
@@ -69,10 +92,12 @@ public:
 
   // The DMR Id section
   std::string  getDMRIdLookupFile() const;
+  std::string  getDMRIdLookupIndex() const;
   unsigned int getDMRIdLookupTime() const;
 
   // The NXDN Id section
   std::string  getNXDNIdLookupFile() const;
+  std::string  getNXDNIdLookupIndex() const;
   unsigned int getNXDNIdLookupTime() const;
 
   // The Log section
@@ -81,6 +106,9 @@ public:
   std::string  getLogFilePath() const;
   std::string  getLogFileRoot() const;
 
+  // The bridges to run
+  const std::vector<CBridgeConf>& getBridges() const;
+
 private:
   std::string  m_file;
   std::string  m_callsign;
@@ -90,6 +118,8 @@ private:
   std::string  m_localAddress;
   unsigned int m_localPort;
   bool         m_daemon;
+  bool         m_threaded;
+  unsigned int m_workers;
 
   unsigned int m_rxFrequency;
   unsigned int m_txFrequency;
@@ -117,9 +147,11 @@ private:
   unsigned int m_dmrNetworkJitter;
 
   std::string  m_dmrIdLookupFile;
+  std::string  m_dmrIdLookupIndex;
   unsigned int m_dmrIdLookupTime;
 
   std::string  m_nxdnIdLookupFile;
+  std::string  m_nxdnIdLookupIndex;
   unsigned int m_nxdnIdLookupTime;
 
   unsigned int m_logDisplayLevel;
@@ -127,6 +159,10 @@ private:
   std::string  m_logFilePath;
   std::string  m_logFileRoot;
 
+  std::vector< std::vector< std::pair<std::string, std::string> > > m_bridgeKeys;
+  std::vector<CBridgeConf> m_bridges;
+
+  void readBridges();
 };
 
 #endif
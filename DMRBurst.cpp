@@ -0,0 +1,143 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "DMRBurst.h"
+#include "Golay2087.h"
+#include "FECTables.h"
+#include "QR1676.h"
+
+#include <cstdio>
+#include <cassert>
+#include <cstdint>
+
+// Bytes 13 to 20 of a burst, MSB first
+const uint64_t SYNC_WORD_MASK      = 0x0FFFFFFFFFFFF000ULL;
+const uint64_t SLOT_TYPE_WORD_MASK = 0xF000000000000FFCULL;
+const uint64_t EMB_WORD_MASK       = 0x0FF00000000FF000ULL;
+
+const uint64_t BS_SOURCED_AUDIO_SYNC_WORD = 0x0755FD7DF75F7000ULL;
+const uint64_t BS_SOURCED_DATA_SYNC_WORD  = 0x0DFF57D75DF5D000ULL;
+const uint64_t MS_SOURCED_AUDIO_SYNC_WORD = 0x07F7D5DD57DFD000ULL;
+const uint64_t MS_SOURCED_DATA_SYNC_WORD  = 0x0D5D7F77FD757000ULL;
+
+// QR (16,7,6) coded EMB, indexed by colour code, PI and LCSS, the first byte
+// of the code word goes before the embedded signalling and the second after it
+static constexpr CLookupTable<uint64_t, 128U> makeEMBTable()
+{
+	CLookupTable<uint64_t, 128U> table = {};
+
+	for (unsigned int emb = 0U; emb < 128U; emb++) {
+		uint64_t code = CQR1676::codeword(emb);
+		table.m_value[emb] = ((code >> 8) << 52) | ((code & 0xFFU) << 12);
+	}
+
+	return table;
+}
+
+// Golay (20,8) coded slot type, indexed by colour code and data type. The first
+// six bits of the code word sit before the word, the next four at its top and
+// the last ten between the sync and the last two bits of the word.
+static constexpr CLookupTable<uint64_t, 256U> makeSlotTypeTable()
+{
+	CLookupTable<uint64_t, 256U> table = {};
+
+	for (unsigned int slotType = 0U; slotType < 256U; slotType++) {
+		uint64_t code = CGolay2087::codeword(slotType);
+		table.m_value[slotType] = (((code >> 10) & 0x0FU) << 60) | ((code & 0x3FFU) << 2);
+	}
+
+	return table;
+}
+
+static constexpr CLookupTable<uint64_t, 128U> EMB_WORD       = makeEMBTable();
+static constexpr CLookupTable<uint64_t, 256U> SLOT_TYPE_WORD = makeSlotTypeTable();
+
+static_assert(CFECTables::hash(EMB_WORD) == 0x588D11C5U, "EMB word table mismatch");
+static_assert(CFECTables::hash(SLOT_TYPE_WORD) == 0x54B103C5U, "Slot type word table mismatch");
+
+static uint64_t getWord(const unsigned char* data)
+{
+	return (uint64_t(data[13U]) << 56) | (uint64_t(data[14U]) << 48) | (uint64_t(data[15U]) << 40) | (uint64_t(data[16U]) << 32) |
+	       (uint64_t(data[17U]) << 24) | (uint64_t(data[18U]) << 16) | (uint64_t(data[19U]) << 8)  | uint64_t(data[20U]);
+}
+
+static void setWord(unsigned char* data, uint64_t word)
+{
+	data[13U] = word >> 56;
+	data[14U] = word >> 48;
+	data[15U] = word >> 40;
+	data[16U] = word >> 32;
+	data[17U] = word >> 24;
+	data[18U] = word >> 16;
+	data[19U] = word >> 8;
+	data[20U] = word >> 0;
+}
+
+void CDMRBurst::addAudioSync(unsigned char* data, bool duplex)
+{
+	assert(data != NULL);
+
+	uint64_t sync = duplex ? BS_SOURCED_AUDIO_SYNC_WORD : MS_SOURCED_AUDIO_SYNC_WORD;
+
+	setWord(data, (getWord(data) & ~SYNC_WORD_MASK) | sync);
+}
+
+void CDMRBurst::addDataSync(unsigned char* data, bool duplex)
+{
+	assert(data != NULL);
+
+	uint64_t sync = duplex ? BS_SOURCED_DATA_SYNC_WORD : MS_SOURCED_DATA_SYNC_WORD;
+
+	setWord(data, (getWord(data) & ~SYNC_WORD_MASK) | sync);
+}
+
+void CDMRBurst::addDataSync(unsigned char* data, bool duplex, unsigned char colorCode, unsigned char dataType)
+{
+	assert(data != NULL);
+
+	unsigned char slotType = ((colorCode << 4) & 0xF0U) | (dataType & 0x0FU);
+
+	uint64_t sync = duplex ? BS_SOURCED_DATA_SYNC_WORD : MS_SOURCED_DATA_SYNC_WORD;
+
+	setWord(data, (getWord(data) & ~(SYNC_WORD_MASK | SLOT_TYPE_WORD_MASK)) | sync | SLOT_TYPE_WORD[slotType]);
+
+	// The first six bits of the slot type sit before the word
+	data[12U] = (data[12U] & 0xC0U) | (slotType >> 2);
+}
+
+void CDMRBurst::addSlotType(unsigned char* data, unsigned char colorCode, unsigned char dataType)
+{
+	assert(data != NULL);
+
+	unsigned char slotType = ((colorCode << 4) & 0xF0U) | (dataType & 0x0FU);
+
+	setWord(data, (getWord(data) & ~SLOT_TYPE_WORD_MASK) | SLOT_TYPE_WORD[slotType]);
+
+	// The first six bits of the slot type sit before the word
+	data[12U] = (data[12U] & 0xC0U) | (slotType >> 2);
+}
+
+void CDMRBurst::addEMB(unsigned char* data, unsigned char colorCode, bool pi, unsigned char lcss)
+{
+	assert(data != NULL);
+
+	unsigned int emb = ((colorCode << 3) & 0x78U) | (pi ? 0x04U : 0x00U) | (lcss & 0x03U);
+
+	setWord(data, (getWord(data) & ~EMB_WORD_MASK) | EMB_WORD[emb]);
+}
@@ -0,0 +1,42 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(DMRBURST_H)
+#define DMRBURST_H
+
+// The centre of a DMR burst carries the sync, with the slot type either side
+// of it in data bursts, or the EMB either side of the embedded signalling in
+// voice bursts B to F. Bytes 13 to 20 are handled as one big endian word so
+// each field is written with a single mask and OR from a precomputed table.
+class CDMRBurst
+{
+public:
+	static void addAudioSync(unsigned char* data, bool duplex);
+	static void addDataSync(unsigned char* data, bool duplex);
+
+	static void addDataSync(unsigned char* data, bool duplex, unsigned char colorCode, unsigned char dataType);
+
+	static void addSlotType(unsigned char* data, unsigned char colorCode, unsigned char dataType);
+
+	static void addEMB(unsigned char* data, unsigned char colorCode, bool pi, unsigned char lcss);
+
+private:
+};
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "DMRCallTemplate.h"
+#include "DMREmbeddedData.h"
+#include "DMRFullLC.h"
+#include "DMRBurst.h"
+#include "DMRLC.h"
+
+#include <cstdio>
+#include <cassert>
+#include <cstring>
+
+// Bytes 13 to 19 of a burst, masked with SYNC_MASK
+const unsigned int VOICE_FRAGMENT_LENGTH = 7U;
+
+CDMRCallTemplate::CDMRCallTemplate() :
+m_valid(false),
+m_srcId(0U),
+m_dstId(0U),
+m_flco(FLCO_GROUP),
+m_colorCode(0U),
+m_header(NULL),
+m_terminator(NULL),
+m_voice(NULL)
+{
+	m_header     = new unsigned char[DMR_FRAME_LENGTH_BYTES];
+	m_terminator = new unsigned char[DMR_FRAME_LENGTH_BYTES];
+	m_voice      = new unsigned char[6U * VOICE_FRAGMENT_LENGTH];
+}
+
+CDMRCallTemplate::~CDMRCallTemplate()
+{
+	delete[] m_header;
+	delete[] m_terminator;
+	delete[] m_voice;
+}
+
+void CDMRCallTemplate::setCall(unsigned int srcId, unsigned int dstId, FLCO flco, unsigned int colorCode)
+{
+	if (m_valid && srcId == m_srcId && dstId == m_dstId && flco == m_flco && colorCode == m_colorCode)
+		return;
+
+	m_srcId     = srcId;
+	m_dstId     = dstId;
+	m_flco      = flco;
+	m_colorCode = colorCode;
+
+	encodeBurst(m_header, DT_VOICE_LC_HEADER);
+	encodeBurst(m_terminator, DT_TERMINATOR_WITH_LC);
+
+	CDMRLC lc(m_flco, m_srcId, m_dstId);
+
+	CDMREmbeddedData embeddedLC;
+	embeddedLC.setLC(lc);
+
+	for (unsigned int n = 0U; n < 6U; n++) {
+		unsigned char burst[DMR_FRAME_LENGTH_BYTES];
+		::memset(burst, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+		if (n == 0U) {
+			CDMRBurst::addAudioSync(burst, false);
+		} else {
+			unsigned char lcss = embeddedLC.getData(burst, n);
+			CDMRBurst::addEMB(burst, m_colorCode, false, lcss);
+		}
+
+		for (unsigned int i = 0U; i < VOICE_FRAGMENT_LENGTH; i++)
+			m_voice[n * VOICE_FRAGMENT_LENGTH + i] = burst[i + 13U] & SYNC_MASK[i];
+	}
+
+	m_valid = true;
+}
+
+void CDMRCallTemplate::getHeader(unsigned char* data) const
+{
+	assert(data != NULL);
+	assert(m_valid);
+
+	::memcpy(data, m_header, DMR_FRAME_LENGTH_BYTES);
+}
+
+void CDMRCallTemplate::getTerminator(unsigned char* data) const
+{
+	assert(data != NULL);
+	assert(m_valid);
+
+	::memcpy(data, m_terminator, DMR_FRAME_LENGTH_BYTES);
+}
+
+void CDMRCallTemplate::getVoice(unsigned char* data, unsigned int n) const
+{
+	assert(data != NULL);
+	assert(n < 6U);
+	assert(m_valid);
+
+	const unsigned char* fragment = m_voice + n * VOICE_FRAGMENT_LENGTH;
+
+	for (unsigned int i = 0U; i < VOICE_FRAGMENT_LENGTH; i++)
+		data[i + 13U] = (data[i + 13U] & ~SYNC_MASK[i]) | fragment[i];
+}
+
+void CDMRCallTemplate::encodeBurst(unsigned char* data, unsigned char dataType) const
+{
+	::memset(data, 0x00U, DMR_FRAME_LENGTH_BYTES);
+
+	// Add sync and SlotType
+	CDMRBurst::addDataSync(data, false, m_colorCode, dataType);
+
+	// Full LC
+	CDMRLC lc(m_flco, m_srcId, m_dstId);
+	CDMRFullLC fullLC;
+	fullLC.encode(lc, data, dataType);
+}
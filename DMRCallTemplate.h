@@ -0,0 +1,55 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(DMRCALLTEMPLATE_H)
+#define	DMRCALLTEMPLATE_H
+
+#include "DMRDefines.h"
+
+// The parts of the outgoing DMR bursts that only depend on the call. The
+// header and terminator bursts and the sync or EMB and embedded LC fragment of
+// each superframe position are encoded once, a voice burst then only needs
+// its middle 48 bits replaced.
+class CDMRCallTemplate {
+public:
+	CDMRCallTemplate();
+	~CDMRCallTemplate();
+
+	// The bursts are only encoded again when one of the values has changed
+	void setCall(unsigned int srcId, unsigned int dstId, FLCO flco, unsigned int colorCode);
+
+	void getHeader(unsigned char* data) const;
+	void getTerminator(unsigned char* data) const;
+
+	// The sync for n = 0, the EMB and embedded LC fragment for n = 1 to 5
+	void getVoice(unsigned char* data, unsigned int n) const;
+
+private:
+	bool           m_valid;
+	unsigned int   m_srcId;
+	unsigned int   m_dstId;
+	FLCO           m_flco;
+	unsigned int   m_colorCode;
+	unsigned char* m_header;
+	unsigned char* m_terminator;
+	unsigned char* m_voice;
+
+	void encodeBurst(unsigned char* data, unsigned char dataType) const;
+};
+
+#endif
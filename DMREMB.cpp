@@ -18,6 +18,7 @@
 
 #include "DMREMB.h"
 
+#include "DMRBurst.h"
 #include "QR1676.h"
 
 #include <cstdio>
@@ -55,18 +56,7 @@ void CDMREMB::getData(unsigned char* data) const
 {
 	assert(data != NULL);
 
-	unsigned char DMREMB[2U];
-	DMREMB[0U]  = (m_colorCode << 4) & 0xF0U;
-	DMREMB[0U] |= m_PI ? 0x08U : 0x00U;
-	DMREMB[0U] |= (m_LCSS << 1) & 0x06U;
-	DMREMB[1U]  = 0x00U;
-
-	CQR1676::encode(DMREMB);
-
-	data[13U] = (data[13U] & 0xF0U) | ((DMREMB[0U] >> 4U) & 0x0FU);
-	data[14U] = (data[14U] & 0x0FU) | ((DMREMB[0U] << 4U) & 0xF0U);
-	data[18U] = (data[18U] & 0xF0U) | ((DMREMB[1U] >> 4U) & 0x0FU);
-	data[19U] = (data[19U] & 0x0FU) | ((DMREMB[1U] << 4U) & 0xF0U);
+	CDMRBurst::addEMB(data, m_colorCode, m_PI, m_LCSS);
 }
 
 unsigned char CDMREMB::getColorCode() const
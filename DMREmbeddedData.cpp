@@ -19,28 +19,38 @@
 #include "DMREmbeddedData.h"
 
 #include "Hamming.h"
-#include "Utils.h"
 #include "CRC.h"
 
 #include <cstdio>
 #include <cassert>
-#include <cstring>
+#include <cstdint>
+
+// Swap rows and columns of an 8x8 bit matrix held one row per byte, MSB first
+static uint64_t transpose8(uint64_t x)
+{
+	uint64_t t;
+
+	t = (x ^ (x >> 7))  & 0x00AA00AA00AA00AAULL;
+	x = x ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+	x = x ^ t ^ (t << 14);
+	t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+	x = x ^ t ^ (t << 28);
+
+	return x;
+}
 
 CDMREmbeddedData::CDMREmbeddedData() :
-m_raw(NULL),
+m_raw(),
 m_state(LCS_NONE),
-m_data(NULL),
+m_data(),
 m_FLCO(FLCO_GROUP),
 m_valid(false)
 {
-	m_raw  = new bool[128U];
-	m_data = new bool[72U];
 }
 
 CDMREmbeddedData::~CDMREmbeddedData()
 {
-	delete[] m_raw;
-	delete[] m_data;
 }
 
 // Add LC data (which may consist of 4 blocks) to the data store
@@ -48,17 +58,12 @@ bool CDMREmbeddedData::addData(const unsigned char* data, unsigned char lcss)
 {
 	assert(data != NULL);
 
-	bool rawData[40U];
-	CUtils::byteToBitsBE(data[14U], rawData + 0U);
-	CUtils::byteToBitsBE(data[15U], rawData + 8U);
-	CUtils::byteToBitsBE(data[16U], rawData + 16U);
-	CUtils::byteToBitsBE(data[17U], rawData + 24U);
-	CUtils::byteToBitsBE(data[18U], rawData + 32U);
+	// The 32 bits of LC sit between the two halves of the EMB
+	unsigned int rawData = ((data[14U] & 0x0FU) << 28) | (data[15U] << 20) | (data[16U] << 12) | (data[17U] << 4) | (data[18U] >> 4);
 
 	// Is this the first block of a 4 block embedded LC ?
 	if (lcss == 1U) {
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_raw[a] = rawData[a + 4U];
+		m_raw.setField(0U, 32U, rawData);
 
 		// Show we are ready for the next LC block
 		m_state = LCS_FIRST;
@@ -69,8 +74,7 @@ bool CDMREmbeddedData::addData(const unsigned char* data, unsigned char lcss)
 
 	// Is this the 2nd block of a 4 block embedded LC ?
 	if (lcss == 3U && m_state == LCS_FIRST) {
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_raw[a + 32U] = rawData[a + 4U];
+		m_raw.setField(32U, 32U, rawData);
 
 		// Show we are ready for the next LC block
 		m_state = LCS_SECOND;
@@ -80,8 +84,7 @@ bool CDMREmbeddedData::addData(const unsigned char* data, unsigned char lcss)
 
 	// Is this the 3rd block of a 4 block embedded LC ?
 	if (lcss == 3U && m_state == LCS_SECOND) {
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_raw[a + 64U] = rawData[a + 4U];
+		m_raw.setField(64U, 32U, rawData);
 
 		// Show we are ready for the final LC block
 		m_state = LCS_THIRD;
@@ -91,8 +94,7 @@ bool CDMREmbeddedData::addData(const unsigned char* data, unsigned char lcss)
 
 	// Is this the final block of a 4 block embedded LC ?
 	if (lcss == 2U && m_state == LCS_THIRD)	{
-		for (unsigned int a = 0U; a < 32U; a++)
-			m_raw[a + 96U] = rawData[a + 4U];
+		m_raw.setField(96U, 32U, rawData);
 
 		// Show that we're not ready for any more data
 		m_state = LCS_NONE;
@@ -118,52 +120,49 @@ void CDMREmbeddedData::setLC(const CDMRLC& lc)
 	encodeEmbeddedData();
 }
 
+// The LC is sent as eight rows of 16 bits, column parity in the last one
 void CDMREmbeddedData::encodeEmbeddedData()
 {
+	unsigned char bytes[9U];
+	m_data.getBytes(bytes, 0U, 72U);
+
 	unsigned int crc;
-	CCRC::encodeFiveBit(m_data, crc);
+	CCRC::encodeFiveBit(bytes, crc);
 
-	bool data[128U];
-	::memset(data, 0x00U, 128U * sizeof(bool));
+	// Eleven data bits in the first two rows, ten and a CRC bit in the next five
+	unsigned int rows[8U];
+	unsigned int b = 0U;
+	for (unsigned int r = 0U; r < 7U; r++) {
+		unsigned int len = r < 2U ? 11U : 10U;
 
-	data[106U] = (crc & 0x01U) == 0x01U;
-	data[90U]  = (crc & 0x02U) == 0x02U;
-	data[74U]  = (crc & 0x04U) == 0x04U;
-	data[58U]  = (crc & 0x08U) == 0x08U;
-	data[42U]  = (crc & 0x10U) == 0x10U;
+		unsigned int row = m_data.getField(b, len);
+		b += len;
 
-	unsigned int b = 0U;
-	for (unsigned int a = 0U; a < 11U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 16U; a < 27U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 32U; a < 42U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 48U; a < 58U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 64U; a < 74U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 80U; a < 90U; a++, b++)
-		data[a] = m_data[b];
-	for (unsigned int a = 96U; a < 106U; a++, b++)
-		data[a] = m_data[b];
+		if (r >= 2U)
+			row = (row << 1) | ((crc >> (6U - r)) & 0x01U);
 
-	// Hamming (16,11,4) check each row except the last one
-	for (unsigned int a = 0U; a < 112U; a += 16U)
-		CHamming::encode16114(data + a);
+		// Hamming (16,11,4) check each row except the last one
+		rows[r] = CHamming::encode16114(row << 5);
+	}
 
 	// Add the parity bits for each column
-	for (unsigned int a = 0U; a < 16U; a++)
-		data[a + 112U] = data[a + 0U] ^ data[a + 16U] ^ data[a + 32U] ^ data[a + 48U] ^ data[a + 64U] ^ data[a + 80U] ^ data[a + 96U];
-
-	// The data is packed downwards in columns
-	b = 0U;
-	for (unsigned int a = 0U; a < 128U; a++) {
-		m_raw[a] = data[b];
-		b += 16U;
-		if (b > 127U)
-			b -= 127U;
+	rows[7U] = rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[4U] ^ rows[5U] ^ rows[6U];
+
+	// The data is packed downwards in columns, one byte per column
+	uint64_t left  = 0U;
+	uint64_t right = 0U;
+	for (unsigned int r = 0U; r < 8U; r++) {
+		left  = (left  << 8) | (rows[r] >> 8);
+		right = (right << 8) | (rows[r] & 0xFFU);
 	}
+
+	left  = transpose8(left);
+	right = transpose8(right);
+
+	m_raw.setField(0U,  32U, left >> 32);
+	m_raw.setField(32U, 32U, left);
+	m_raw.setField(64U, 32U, right >> 32);
+	m_raw.setField(96U, 32U, right);
 }
 
 unsigned char CDMREmbeddedData::getData(unsigned char* data, unsigned char n) const
@@ -173,22 +172,13 @@ unsigned char CDMREmbeddedData::getData(unsigned char* data, unsigned char n) co
 	if (n >= 1U && n < 5U) {
 		n--;
 
-		bool bits[40U];
-		::memset(bits, 0x00U, 40U * sizeof(bool));
-		::memcpy(bits + 4U, m_raw + n * 32U, 32U * sizeof(bool));
+		unsigned int rawData = m_raw.getField(n * 32U, 32U);
 
-		unsigned char bytes[5U];
-		CUtils::bitsToByteBE(bits + 0U,  bytes[0U]);
-		CUtils::bitsToByteBE(bits + 8U,  bytes[1U]);
-		CUtils::bitsToByteBE(bits + 16U, bytes[2U]);
-		CUtils::bitsToByteBE(bits + 24U, bytes[3U]);
-		CUtils::bitsToByteBE(bits + 32U, bytes[4U]);
-
-		data[14U] = (data[14U] & 0xF0U) | (bytes[0U] & 0x0FU);
-		data[15U] = bytes[1U];
-		data[16U] = bytes[2U];
-		data[17U] = bytes[3U];
-		data[18U] = (data[18U] & 0x0FU) | (bytes[4U] & 0xF0U);
+		data[14U] = (data[14U] & 0xF0U) | (rawData >> 28);
+		data[15U] = rawData >> 20;
+		data[16U] = rawData >> 12;
+		data[17U] = rawData >> 4;
+		data[18U] = (data[18U] & 0x0FU) | ((rawData << 4) & 0xF0U);
 
 		switch (n) {
 		case 0U:
@@ -212,66 +202,48 @@ unsigned char CDMREmbeddedData::getData(unsigned char* data, unsigned char n) co
 // Unpack and error check an embedded LC
 void CDMREmbeddedData::decodeEmbeddedData()
 {
-	// The data is unpacked downwards in columns
-	bool data[128U];
-	::memset(data, 0x00U, 128U * sizeof(bool));
+	// The data is unpacked downwards in columns, one byte per column
+	uint64_t left  = transpose8((uint64_t(m_raw.getField(0U,  32U)) << 32) | m_raw.getField(32U, 32U));
+	uint64_t right = transpose8((uint64_t(m_raw.getField(64U, 32U)) << 32) | m_raw.getField(96U, 32U));
 
-	unsigned int b = 0U;
-	for (unsigned int a = 0U; a < 128U; a++) {
-		data[b] = m_raw[a];
-		b += 16U;
-		if (b > 127U)
-			b -= 127U;
-	}
+	unsigned int rows[8U];
+	for (unsigned int r = 0U; r < 8U; r++)
+		rows[r] = (((left >> (56U - r * 8U)) & 0xFFU) << 8) | ((right >> (56U - r * 8U)) & 0xFFU);
 
 	// Hamming (16,11,4) check each row except the last one
-	for (unsigned int a = 0U; a < 112U; a += 16U) {
-		if (!CHamming::decode16114(data + a))
+	for (unsigned int r = 0U; r < 7U; r++) {
+		if (!CHamming::decode16114(rows[r]))
 			return;
 	}
 
 	// Check the parity bits
-	for (unsigned int a = 0U; a < 16U; a++) {
-		bool parity = data[a + 0U] ^ data[a + 16U] ^ data[a + 32U] ^ data[a + 48U] ^ data[a + 64U] ^ data[a + 80U] ^ data[a + 96U] ^ data[a + 112U];
-		if (parity)
-			return;
-	}
+	if ((rows[0U] ^ rows[1U] ^ rows[2U] ^ rows[3U] ^ rows[4U] ^ rows[5U] ^ rows[6U] ^ rows[7U]) != 0U)
+		return;
 
-	// We have passed the Hamming check so extract the actual payload
-	b = 0U;
-	for (unsigned int a = 0U; a < 11U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 16U; a < 27U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 32U; a < 42U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 48U; a < 58U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 64U; a < 74U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 80U; a < 90U; a++, b++)
-		m_data[b] = data[a];
-	for (unsigned int a = 96U; a < 106U; a++, b++)
-		m_data[b] = data[a];
-
-	// Extract the 5 bit CRC
+	// We have passed the Hamming check so extract the actual payload, and the 5 bit CRC
 	unsigned int crc = 0U;
-	if (data[42])  crc += 16U;
-	if (data[58])  crc += 8U;
-	if (data[74])  crc += 4U;
-	if (data[90])  crc += 2U;
-	if (data[106]) crc += 1U;
+	unsigned int b = 0U;
+	for (unsigned int r = 0U; r < 7U; r++) {
+		unsigned int len = r < 2U ? 11U : 10U;
+
+		m_data.setField(b, len, rows[r] >> (16U - len));
+		b += len;
+
+		if (r >= 2U)
+			crc = (crc << 1) | ((rows[r] >> 5) & 0x01U);
+	}
 
 	// Now CRC check this
-	if (!CCRC::checkFiveBit(m_data, crc))
+	unsigned char bytes[9U];
+	m_data.getBytes(bytes, 0U, 72U);
+
+	if (!CCRC::checkFiveBit(bytes, crc))
 		return;
 
 	m_valid = true;
 
 	// Extract the FLCO
-	unsigned char flco;
-	CUtils::bitsToByteBE(m_data + 0U, flco);
-	m_FLCO = FLCO(flco & 0x3FU);
+	m_FLCO = FLCO(m_data.getField(2U, 6U));
 }
 
 CDMRLC* CDMREmbeddedData::getLC() const
@@ -308,15 +280,7 @@ bool CDMREmbeddedData::getRawData(unsigned char* data) const
 	if (!m_valid)
 		return false;
 
-	CUtils::bitsToByteBE(m_data + 0U,  data[0U]);
-	CUtils::bitsToByteBE(m_data + 8U,  data[1U]);
-	CUtils::bitsToByteBE(m_data + 16U, data[2U]);
-	CUtils::bitsToByteBE(m_data + 24U, data[3U]);
-	CUtils::bitsToByteBE(m_data + 32U, data[4U]);
-	CUtils::bitsToByteBE(m_data + 40U, data[5U]);
-	CUtils::bitsToByteBE(m_data + 48U, data[6U]);
-	CUtils::bitsToByteBE(m_data + 56U, data[7U]);
-	CUtils::bitsToByteBE(m_data + 64U, data[8U]);
+	m_data.getBytes(data, 0U, 72U);
 
 	return true;
 }
@@ -21,6 +21,7 @@
 
 #include "DMRDefines.h"
 #include "DMRLC.h"
+#include "BitVector.h"
 
 enum LC_STATE {
 	LCS_NONE,
@@ -50,11 +51,11 @@ public:
 	void reset();
 
 private:
-	bool*        m_raw;
-	LC_STATE     m_state;
-	bool*        m_data;
-	FLCO         m_FLCO;
-	bool         m_valid;
+	CBitVector<128U> m_raw;
+	LC_STATE         m_state;
+	CBitVector<72U>  m_data;
+	FLCO             m_FLCO;
+	bool             m_valid;
 
 	void decodeEmbeddedData();
 	void encodeEmbeddedData();
@@ -18,8 +18,6 @@
 
 #include "DMRLC.h"
 
-#include "Utils.h"
-
 #include <cstdio>
 #include <cassert>
 
@@ -58,7 +56,7 @@ m_dstId(0U)
 	m_srcId = bytes[6U] << 16 | bytes[7U] << 8 | bytes[8U];
 }
 
-CDMRLC::CDMRLC(const bool* bits) :
+CDMRLC::CDMRLC(const CBitVector<72U>& bits) :
 m_PF(false),
 m_R(false),
 m_FLCO(FLCO_GROUP),
@@ -67,33 +65,17 @@ m_options(0U),
 m_srcId(0U),
 m_dstId(0U)
 {
-	assert(bits != NULL);
-
-	m_PF = bits[0U];
-	m_R  = bits[1U];
-
-	unsigned char temp1, temp2, temp3;
-	CUtils::bitsToByteBE(bits + 0U, temp1);
-	m_FLCO = FLCO(temp1 & 0x3FU);
+	m_PF = bits.getBit(0U);
+	m_R  = bits.getBit(1U);
 
-	CUtils::bitsToByteBE(bits + 8U, temp2);
-	m_FID = temp2;
+	m_FLCO = FLCO(bits.getField(2U, 6U));
 
-	CUtils::bitsToByteBE(bits + 16U, temp3);
-	m_options = temp3;
+	m_FID = bits.getField(8U, 8U);
 
-	unsigned char d1, d2, d3;
-	CUtils::bitsToByteBE(bits + 24U, d1);
-	CUtils::bitsToByteBE(bits + 32U, d2);
-	CUtils::bitsToByteBE(bits + 40U, d3);
+	m_options = bits.getField(16U, 8U);
 
-	unsigned char s1, s2, s3;
-	CUtils::bitsToByteBE(bits + 48U, s1);
-	CUtils::bitsToByteBE(bits + 56U, s2);
-	CUtils::bitsToByteBE(bits + 64U, s3);
-
-	m_srcId = s1 << 16 | s2 << 8 | s3;
-	m_dstId = d1 << 16 | d2 << 8 | d3;
+	m_dstId = bits.getField(24U, 24U);
+	m_srcId = bits.getField(48U, 24U);
 }
 
 CDMRLC::CDMRLC() :
@@ -136,22 +118,19 @@ void CDMRLC::getData(unsigned char* bytes) const
 	bytes[8U] = m_srcId >> 0;
 }
 
-void CDMRLC::getData(bool* bits) const
+void CDMRLC::getData(CBitVector<72U>& bits) const
 {
-	assert(bits != NULL);
+	bits.setBit(0U, m_PF);
+	bits.setBit(1U, m_R);
+
+	bits.setField(2U, 6U, m_FLCO);
+
+	bits.setField(8U, 8U, m_FID);
 
-	unsigned char bytes[9U];
-	getData(bytes);
+	bits.setField(16U, 8U, m_options);
 
-	CUtils::byteToBitsBE(bytes[0U], bits + 0U);
-	CUtils::byteToBitsBE(bytes[1U], bits + 8U);
-	CUtils::byteToBitsBE(bytes[2U], bits + 16U);
-	CUtils::byteToBitsBE(bytes[3U], bits + 24U);
-	CUtils::byteToBitsBE(bytes[4U], bits + 32U);
-	CUtils::byteToBitsBE(bytes[5U], bits + 40U);
-	CUtils::byteToBitsBE(bytes[6U], bits + 48U);
-	CUtils::byteToBitsBE(bytes[7U], bits + 56U);
-	CUtils::byteToBitsBE(bytes[8U], bits + 64U);
+	bits.setField(24U, 24U, m_dstId);
+	bits.setField(48U, 24U, m_srcId);
 }
 
 bool CDMRLC::getPF() const
@@ -20,18 +20,19 @@
 #define DMRLC_H
 
 #include "DMRDefines.h"
+#include "BitVector.h"
 
 class CDMRLC
 {
 public:
 	CDMRLC(FLCO flco, unsigned int srcId, unsigned int dstId);
 	CDMRLC(const unsigned char* bytes);
-	CDMRLC(const bool* bits);
+	CDMRLC(const CBitVector<72U>& bits);
 	CDMRLC();
 	~CDMRLC();
 
 	void getData(unsigned char* bytes) const;
-	void getData(bool* bits) const;
+	void getData(CBitVector<72U>& bits) const;
 
 	bool getPF() const;
 	void setPF(bool pf);
@@ -30,6 +30,7 @@
 const unsigned int BUFFER_LENGTH = 500U;
 
 const unsigned int HOMEBREW_DATA_PACKET_LENGTH = 55U;
+const unsigned int HOMEBREW_HEADER_LENGTH      = 20U;
 
 CDMRNetwork::CDMRNetwork(const std::string& address, unsigned int port, unsigned int local, unsigned int id, const std::string& password, bool duplex, const char* version, bool debug, bool slot1, bool slot2, HW_TYPE hwType, unsigned int jitter) :
 m_address(),
@@ -49,6 +50,13 @@ m_status(WAITING_CONNECT),
 m_retryTimer(1000U, 10U),
 m_timeoutTimer(1000U, 60U),
 m_buffer(NULL),
+m_batch(NULL),
+m_header(NULL),
+m_headerValid(false),
+m_headerSrcId(0U),
+m_headerDstId(0U),
+m_headerSlotNo(0U),
+m_headerFLCO(FLCO_GROUP),
 m_salt(NULL),
 m_streamId(NULL),
 m_options(),
@@ -63,7 +71,8 @@ m_height(0),
 m_location(),
 m_description(),
 m_url(),
-m_beacon(false)
+m_beacon(false),
+m_mutex()
 {
 	assert(!address.empty());
 	assert(port > 0U);
@@ -74,6 +83,8 @@ m_beacon(false)
 	m_address = CUDPSocket::lookup(address);
 
 	m_buffer        = new unsigned char[BUFFER_LENGTH];
+	m_batch         = new CUDPDatagram[UDP_BATCH_SIZE];
+	m_header        = new unsigned char[HOMEBREW_HEADER_LENGTH];
 	m_salt          = new unsigned char[sizeof(uint32_t)];
 	m_id            = new uint8_t[4U];
 	m_streamId      = new uint32_t[2U];
@@ -101,6 +112,8 @@ CDMRNetwork::~CDMRNetwork()
 	delete m_delayBuffers[2U];
 
 	delete[] m_buffer;
+	delete[] m_batch;
+	delete[] m_header;
 	delete[] m_salt;
 	delete[] m_streamId;
 	delete[] m_id;
@@ -128,6 +141,11 @@ void CDMRNetwork::setConfig(const std::string& callsign, unsigned int rxFrequenc
 	m_url         = url;
 }
 
+void CDMRNetwork::setReactor(CReactor* reactor)
+{
+	m_socket.setReactor(reactor);
+}
+
 bool CDMRNetwork::open()
 {
 	LogMessage("DMR, Opening DMR Network");
@@ -145,6 +163,15 @@ void CDMRNetwork::enable(bool enabled)
 }
 
 bool CDMRNetwork::read(CDMRData& data)
+{
+	m_mutex.lock();
+	bool ret = readData(data);
+	m_mutex.unlock();
+
+	return ret;
+}
+
+bool CDMRNetwork::readData(CDMRData& data)
 {
 	if (m_status != RUNNING)
 		return false;
@@ -170,6 +197,8 @@ bool CDMRNetwork::read(CDMRData& data)
 			data.setDstId(dstId);
 			data.setFLCO(flco);
 			data.setMissing(status == BS_MISSING);
+			data.setBER(m_buffer[53U]);
+			data.setRSSI(m_buffer[54U]);
 
 			bool dataSync = (m_buffer[15U] & 0x20U) == 0x20U;
 			bool voiceSync = (m_buffer[15U] & 0x10U) == 0x10U;
@@ -199,28 +228,17 @@ bool CDMRNetwork::read(CDMRData& data)
 
 bool CDMRNetwork::write(const CDMRData& data)
 {
-	if (m_status != RUNNING)
-		return false;
+	m_mutex.lock();
+	bool ret = writeData(data);
+	m_mutex.unlock();
 
-	unsigned char buffer[HOMEBREW_DATA_PACKET_LENGTH];
-	::memset(buffer, 0x00U, HOMEBREW_DATA_PACKET_LENGTH);
-
-	buffer[0U]  = 'D';
-	buffer[1U]  = 'M';
-	buffer[2U]  = 'R';
-	buffer[3U]  = 'D';
-
-	unsigned int srcId = data.getSrcId();
-	buffer[5U]  = srcId >> 16;
-	buffer[6U]  = srcId >> 8;
-	buffer[7U]  = srcId >> 0;
-
-	unsigned int dstId = data.getDstId();
-	buffer[8U]  = dstId >> 16;
-	buffer[9U]  = dstId >> 8;
-	buffer[10U] = dstId >> 0;
+	return ret;
+}
 
-	::memcpy(buffer + 11U, m_id, 4U);
+bool CDMRNetwork::writeData(const CDMRData& data)
+{
+	if (m_status != RUNNING)
+		return false;
 
 	unsigned int slotNo = data.getSlotNo();
 
@@ -230,12 +248,23 @@ bool CDMRNetwork::write(const CDMRData& data)
 	if (slotNo == 2U && !m_slot2)
 		return false;
 
-	buffer[15U] = slotNo == 1U ? 0x00U : 0x80U;
-
+	unsigned int srcId = data.getSrcId();
+	unsigned int dstId = data.getDstId();
 	FLCO flco = data.getFLCO();
-	buffer[15U] |= flco == FLCO_GROUP ? 0x00U : 0x40U;
 
-	unsigned int slotIndex = slotNo - 1U;
+	// The header only changes between calls, it is built once and then copied
+	if (!m_headerValid || srcId != m_headerSrcId || dstId != m_headerDstId || slotNo != m_headerSlotNo || flco != m_headerFLCO) {
+		writeHeader(srcId, dstId, slotNo, flco);
+
+		m_headerValid  = true;
+		m_headerSrcId  = srcId;
+		m_headerDstId  = dstId;
+		m_headerSlotNo = slotNo;
+		m_headerFLCO   = flco;
+	}
+
+	unsigned char buffer[HOMEBREW_DATA_PACKET_LENGTH];
+	::memcpy(buffer, m_header, HOMEBREW_HEADER_LENGTH);
 
 	unsigned int count = 1U;
 
@@ -253,8 +282,6 @@ bool CDMRNetwork::write(const CDMRData& data)
 
 	buffer[4U] = data.getSeqNo();
 
-	::memcpy(buffer + 16U, m_streamId + slotIndex, 4U);
-
 	data.getData(buffer + 20U);
 
 	buffer[53U] = data.getBER();
@@ -264,12 +291,37 @@ bool CDMRNetwork::write(const CDMRData& data)
 	if (m_debug)
 		CUtils::dump(1U, "Network Transmitted", buffer, HOMEBREW_DATA_PACKET_LENGTH);
 
-	for (unsigned int i = 0U; i < count; i++)
-		write(buffer, HOMEBREW_DATA_PACKET_LENGTH);
+	write(buffer, HOMEBREW_DATA_PACKET_LENGTH, count);
 
 	return true;
 }
 
+// Everything but the sequence number and the frame type bits
+void CDMRNetwork::writeHeader(unsigned int srcId, unsigned int dstId, unsigned int slotNo, FLCO flco)
+{
+	::memset(m_header, 0x00U, HOMEBREW_HEADER_LENGTH);
+
+	m_header[0U]  = 'D';
+	m_header[1U]  = 'M';
+	m_header[2U]  = 'R';
+	m_header[3U]  = 'D';
+
+	m_header[5U]  = srcId >> 16;
+	m_header[6U]  = srcId >> 8;
+	m_header[7U]  = srcId >> 0;
+
+	m_header[8U]  = dstId >> 16;
+	m_header[9U]  = dstId >> 8;
+	m_header[10U] = dstId >> 0;
+
+	::memcpy(m_header + 11U, m_id, 4U);
+
+	m_header[15U] = slotNo == 1U ? 0x00U : 0x80U;
+	m_header[15U] |= flco == FLCO_GROUP ? 0x00U : 0x40U;
+
+	::memcpy(m_header + 16U, m_streamId + slotNo - 1U, 4U);
+}
+
 bool CDMRNetwork::writePosition(unsigned int id, const unsigned char* data)
 {
 	if (m_status != RUNNING)
@@ -313,6 +365,13 @@ bool CDMRNetwork::writeTalkerAlias(unsigned int id, unsigned char type, const un
 }
 
 void CDMRNetwork::close()
+{
+	m_mutex.lock();
+	closeNetwork();
+	m_mutex.unlock();
+}
+
+void CDMRNetwork::closeNetwork()
 {
 	LogMessage("DMR, Closing DMR Network");
 
@@ -329,7 +388,58 @@ void CDMRNetwork::close()
 	m_timeoutTimer.stop();
 }
 
+void CDMRNetwork::receive()
+{
+	m_mutex.lock();
+	receiveNetwork();
+	m_mutex.unlock();
+}
+
+void CDMRNetwork::receiveNetwork()
+{
+	// There is no socket until the retry timer opens it
+	if (m_status == WAITING_CONNECT)
+		return;
+
+	// Drain all the queued datagrams, a recvmmsg() batch at a time
+	for (;;) {
+		int n = m_socket.read(m_batch, UDP_BATCH_SIZE);
+		if (n < 0) {
+			LogError("DMR, Socket has failed, retrying connection to the master");
+			closeNetwork();
+			open();
+			return;
+		}
+
+		for (int i = 0; i < n; i++) {
+			const CUDPDatagram& datagram = m_batch[i];
+
+			// if (m_debug)
+			//	CUtils::dump(1U, "Network Received", datagram.m_data, datagram.m_length);
+
+			if (m_address.s_addr != datagram.m_address.s_addr || m_port != datagram.m_port)
+				continue;
+
+			receivePacket(datagram.m_data, datagram.m_length);
+
+			// The packet, or a failed reply to it, has restarted the connection
+			if (m_status == WAITING_CONNECT)
+				return;
+		}
+
+		if (n < int(UDP_BATCH_SIZE))
+			break;
+	}
+}
+
 void CDMRNetwork::clock(unsigned int ms)
+{
+	m_mutex.lock();
+	clockNetwork(ms);
+	m_mutex.unlock();
+}
+
+void CDMRNetwork::clockNetwork(unsigned int ms)
 {
 	m_delayBuffers[1U]->clock(ms);
 	m_delayBuffers[2U]->clock(ms);
@@ -339,6 +449,8 @@ void CDMRNetwork::clock(unsigned int ms)
 		if (m_retryTimer.isRunning() && m_retryTimer.hasExpired()) {
 			bool ret = m_socket.open();
 			if (ret) {
+				m_socket.connect(m_address, m_port);
+
 				ret = writeLogin();
 				if (!ret)
 					return;
@@ -353,92 +465,6 @@ void CDMRNetwork::clock(unsigned int ms)
 		return;
 	}
 
-	in_addr address;
-	unsigned int port;
-	int length = m_socket.read(m_buffer, BUFFER_LENGTH, address, port);
-	if (length < 0) {
-		LogError("DMR, Socket has failed, retrying connection to the master");
-		close();
-		open();
-		return;
-	}
-
-	// if (m_debug && length > 0)
-	//	CUtils::dump(1U, "Network Received", m_buffer, length);
-
-	if (length > 0 && m_address.s_addr == address.s_addr && m_port == port) {
-		if (::memcmp(m_buffer, "DMRD", 4U) == 0) {
-			if (m_enabled) {
-				if (m_debug)
-					CUtils::dump(1U, "Network Received", m_buffer, length);
-				receiveData(m_buffer, length);
-			}
-		} else if (::memcmp(m_buffer, "MSTNAK",  6U) == 0) {
-			if (m_status == RUNNING) {
-				LogWarning("DMR, Login to the master has failed, retrying login ...");
-				m_status = WAITING_LOGIN;
-				m_timeoutTimer.start();
-				m_retryTimer.start();
-			} else {
-				/* Once the modem death spiral has been prevented in Modem.cpp
-				   the Network sometimes times out and reaches here.
-				   We want it to reconnect so... */
-				LogError("DMR, Login to the master has failed, retrying network ...");
-				close();
-				open();
-				return;
-			}
-		} else if (::memcmp(m_buffer, "RPTACK",  6U) == 0) {
-			switch (m_status) {
-				case WAITING_LOGIN:
-					LogDebug("DMR, Sending authorisation");
-					::memcpy(m_salt, m_buffer + 6U, sizeof(uint32_t));
-					writeAuthorisation();
-					m_status = WAITING_AUTHORISATION;
-					m_timeoutTimer.start();
-					m_retryTimer.start();
-					break;
-				case WAITING_AUTHORISATION:
-					LogDebug("DMR, Sending configuration");
-					writeConfig();
-					m_status = WAITING_CONFIG;
-					m_timeoutTimer.start();
-					m_retryTimer.start();
-					break;
-				case WAITING_CONFIG:
-					if (m_options.empty()) {
-						LogMessage("DMR, Logged into the master successfully");
-						m_status = RUNNING;
-					} else {
-						LogDebug("DMR, Sending options");
-						writeOptions();
-						m_status = WAITING_OPTIONS;
-					}
-					m_timeoutTimer.start();
-					m_retryTimer.start();
-					break;
-				case WAITING_OPTIONS:
-					LogMessage("DMR, Logged into the master successfully");
-					m_status = RUNNING;
-					m_timeoutTimer.start();
-					m_retryTimer.start();
-					break;
-				default:
-					break;
-			}
-		} else if (::memcmp(m_buffer, "MSTCL",   5U) == 0) {
-			LogError("DMR, Master is closing down");
-			close();
-			open();
-		} else if (::memcmp(m_buffer, "MSTPONG", 7U) == 0) {
-			m_timeoutTimer.start();
-		} else if (::memcmp(m_buffer, "RPTSBKN", 7U) == 0) {
-			m_beacon = true;
-		} else {
-			CUtils::dump("Unknown packet from the master", m_buffer, length);
-		}
-	}
-
 	m_retryTimer.clock(ms);
 	if (m_retryTimer.isRunning() && m_retryTimer.hasExpired()) {
 		switch (m_status) {
@@ -467,8 +493,81 @@ void CDMRNetwork::clock(unsigned int ms)
 	m_timeoutTimer.clock(ms);
 	if (m_timeoutTimer.isRunning() && m_timeoutTimer.hasExpired()) {
 		LogError("DMR, Connection to the master has timed out, retrying connection");
-		close();
+		closeNetwork();
+		open();
+	}
+}
+
+void CDMRNetwork::receivePacket(const unsigned char* data, unsigned int length)
+{
+	if (::memcmp(data, "DMRD", 4U) == 0) {
+		if (m_enabled) {
+			if (m_debug)
+				CUtils::dump(1U, "Network Received", data, length);
+			receiveData(data, length);
+		}
+	} else if (::memcmp(data, "MSTNAK",  6U) == 0) {
+		if (m_status == RUNNING) {
+			LogWarning("DMR, Login to the master has failed, retrying login ...");
+			m_status = WAITING_LOGIN;
+			m_timeoutTimer.start();
+			m_retryTimer.start();
+		} else {
+			/* Once the modem death spiral has been prevented in Modem.cpp
+			   the Network sometimes times out and reaches here.
+			   We want it to reconnect so... */
+			LogError("DMR, Login to the master has failed, retrying network ...");
+			closeNetwork();
+			open();
+		}
+	} else if (::memcmp(data, "RPTACK",  6U) == 0) {
+		switch (m_status) {
+			case WAITING_LOGIN:
+				LogDebug("DMR, Sending authorisation");
+				::memcpy(m_salt, data + 6U, sizeof(uint32_t));
+				writeAuthorisation();
+				m_status = WAITING_AUTHORISATION;
+				m_timeoutTimer.start();
+				m_retryTimer.start();
+				break;
+			case WAITING_AUTHORISATION:
+				LogDebug("DMR, Sending configuration");
+				writeConfig();
+				m_status = WAITING_CONFIG;
+				m_timeoutTimer.start();
+				m_retryTimer.start();
+				break;
+			case WAITING_CONFIG:
+				if (m_options.empty()) {
+					LogMessage("DMR, Logged into the master successfully");
+					m_status = RUNNING;
+				} else {
+					LogDebug("DMR, Sending options");
+					writeOptions();
+					m_status = WAITING_OPTIONS;
+				}
+				m_timeoutTimer.start();
+				m_retryTimer.start();
+				break;
+			case WAITING_OPTIONS:
+				LogMessage("DMR, Logged into the master successfully");
+				m_status = RUNNING;
+				m_timeoutTimer.start();
+				m_retryTimer.start();
+				break;
+			default:
+				break;
+		}
+	} else if (::memcmp(data, "MSTCL",   5U) == 0) {
+		LogError("DMR, Master is closing down");
+		closeNetwork();
 		open();
+	} else if (::memcmp(data, "MSTPONG", 7U) == 0) {
+		m_timeoutTimer.start();
+	} else if (::memcmp(data, "RPTSBKN", 7U) == 0) {
+		m_beacon = true;
+	} else {
+		CUtils::dump("Unknown packet from the master", data, length);
 	}
 }
 
@@ -476,6 +575,8 @@ void CDMRNetwork::reset(unsigned int slotNo)
 {
 	assert(slotNo == 1U || slotNo == 2U);
 
+	m_mutex.lock();
+
 	if (slotNo == 1U) {
 		m_delayBuffers[1U]->reset();
 		m_streamId[0U] = ::rand() + 1U;
@@ -483,6 +584,11 @@ void CDMRNetwork::reset(unsigned int slotNo)
 		m_delayBuffers[2U]->reset();
 		m_streamId[1U] = ::rand() + 1U;
 	}
+
+	// The new stream id goes into the next header
+	m_headerValid = false;
+
+	m_mutex.unlock();
 }
 
 bool CDMRNetwork::isConnected() const
@@ -646,15 +752,31 @@ bool CDMRNetwork::wantsBeacon()
 	return beacon;
 }
 
-bool CDMRNetwork::write(const unsigned char* data, unsigned int length)
+bool CDMRNetwork::write(const unsigned char* data, unsigned int length, unsigned int count)
 {
 	assert(data != NULL);
-	assert(length > 0U);
+	assert(length > 0U && length <= UDP_DATAGRAM_LENGTH);
+	assert(count > 0U && count <= UDP_BATCH_SIZE);
 
 	// if (m_debug)
 	//	CUtils::dump(1U, "Network Transmitted", data, length);
 
-	bool ret = m_socket.write(data, length, m_address, m_port);
+	bool ret;
+	if (count == 1U) {
+		ret = m_socket.write(data, length, m_address, m_port);
+	} else {
+		// Repeated packets leave in a single sendmmsg()
+		CUDPDatagram datagrams[UDP_BATCH_SIZE];
+		for (unsigned int i = 0U; i < count; i++) {
+			::memcpy(datagrams[i].m_data, data, length);
+			datagrams[i].m_length  = length;
+			datagrams[i].m_address = m_address;
+			datagrams[i].m_port    = m_port;
+		}
+
+		ret = m_socket.write(datagrams, count);
+	}
+
 	if (!ret) {
 		LogError("DMR, Socket has failed when writing data to the master, retrying connection");
 		m_socket.close();
@@ -24,10 +24,13 @@
 #include "Timer.h"
 #include "DMRData.h"
 #include "Defines.h"
+#include "Mutex.h"
 
 #include <string>
 #include <cstdint>
 
+// The public calls lock the network, so one thread may read and clock it while
+// another writes
 class CDMRNetwork
 {
 public:
@@ -38,6 +41,8 @@ public:
 
 	void setConfig(const std::string& callsign, unsigned int rxFrequency, unsigned int txFrequency, unsigned int power, unsigned int colorCode, float latitude, float longitude, int height, const std::string& location, const std::string& description, const std::string& url);
 
+	void setReactor(CReactor* reactor);
+
 	bool open();
 
 	void enable(bool enabled);
@@ -52,6 +57,10 @@ public:
 
 	bool wantsBeacon();
 
+	// Takes every datagram waiting on the socket, to be called when it is readable
+	void receive();
+
+	// Runs the delay buffers and the login, keepalive and timeout timers
 	void clock(unsigned int ms);
 
 	void reset(unsigned int slotNo);
@@ -88,6 +97,13 @@ private:
 	CTimer         m_retryTimer;
 	CTimer         m_timeoutTimer;
 	unsigned char* m_buffer;
+	CUDPDatagram*  m_batch;
+	unsigned char* m_header;
+	bool           m_headerValid;
+	unsigned int   m_headerSrcId;
+	unsigned int   m_headerDstId;
+	unsigned int   m_headerSlotNo;
+	FLCO           m_headerFLCO;
 	unsigned char* m_salt;
 	uint32_t*      m_streamId;
 
@@ -106,6 +122,15 @@ private:
 	std::string    m_url;
 
 	bool           m_beacon;
+	CMutex         m_mutex;
+
+	bool readData(CDMRData& data);
+	bool writeData(const CDMRData& data);
+	void writeHeader(unsigned int srcId, unsigned int dstId, unsigned int slotNo, FLCO flco);
+	void receiveNetwork();
+	void clockNetwork(unsigned int ms);
+	void closeNetwork();
+	void receivePacket(const unsigned char* data, unsigned int length);
 
 	bool writeLogin();
 	bool writeAuthorisation();
@@ -113,7 +138,7 @@ private:
 	bool writeConfig();
 	bool writePing();
 
-	bool write(const unsigned char* data, unsigned int length);
+	bool write(const unsigned char* data, unsigned int length, unsigned int count = 1U);
 
 	void receiveData(const unsigned char* data, unsigned int length);
 };
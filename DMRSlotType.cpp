@@ -19,6 +19,7 @@
 #include "DMRSlotType.h"
 
 #include "Golay2087.h"
+#include "DMRBurst.h"
 
 #include <cstdio>
 #include <cassert>
@@ -57,18 +58,7 @@ void CDMRSlotType::getData(unsigned char* data) const
 {
 	assert(data != NULL);
 
-	unsigned char DMRSlotType[3U];
-	DMRSlotType[0U]  = (m_colorCode << 4) & 0xF0U;
-	DMRSlotType[0U] |= (m_dataType  << 0) & 0x0FU;
-	DMRSlotType[1U]  = 0x00U;
-	DMRSlotType[2U]  = 0x00U;
-
-	CGolay2087::encode(DMRSlotType);
-
-	data[12U] = (data[12U] & 0xC0U) | ((DMRSlotType[0U] >> 2) & 0x3FU);
-	data[13U] = (data[13U] & 0x0FU) | ((DMRSlotType[0U] << 6) & 0xC0U) | ((DMRSlotType[1U] >> 2) & 0x30U);
-	data[19U] = (data[19U] & 0xF0U) | ((DMRSlotType[1U] >> 2) & 0x0FU);
-	data[20U] = (data[20U] & 0x03U) | ((DMRSlotType[1U] << 6) & 0xC0U) | ((DMRSlotType[2U] >> 2) & 0x3CU);
+	CDMRBurst::addSlotType(data, m_colorCode, m_dataType);
 }
 
 unsigned char CDMRSlotType::getColorCode() const
@@ -0,0 +1,153 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(FECTABLES_H)
+#define	FECTABLES_H
+
+#include <cstdint>
+
+// A table of N values filled in at compile time
+template<typename T, unsigned int N> struct CLookupTable {
+	T m_value[N];
+
+	constexpr const T& operator[](unsigned int n) const
+	{
+		return m_value[n];
+	}
+};
+
+// Compile time builders for the tables of the cyclic block codes, and a hash
+// of a table for checking it against the values it was generated to match
+class CFECTables {
+public:
+	// The remainder of a pattern of length bits on division by a generator polynomial of the given degree
+	static constexpr unsigned int remainder(unsigned int pattern, unsigned int length, unsigned int genpol, unsigned int degree)
+	{
+		for (unsigned int n = length; n > degree; n--) {
+			if ((pattern & (1U << (n - 1U))) != 0U)
+				pattern ^= genpol << (n - 1U - degree);
+		}
+
+		return pattern;
+	}
+
+	// The code word of a systematic cyclic code, the data bits above the remainder
+	static constexpr unsigned int codeword(unsigned int data, unsigned int length, unsigned int genpol, unsigned int degree)
+	{
+		return (data << degree) | remainder(data << degree, length, genpol, degree);
+	}
+
+	static constexpr unsigned int parity(unsigned int v)
+	{
+		unsigned int p = 0U;
+		for (; v != 0U; v >>= 1)
+			p ^= v & 0x01U;
+
+		return p;
+	}
+
+	// A code word followed by an even parity bit over it
+	static constexpr unsigned int extend(unsigned int code)
+	{
+		return (code << 1) | parity(code);
+	}
+
+	// For each syndrome of a code of length bits, the lightest error pattern of up to maxWeight
+	// (at most eight) bits giving it, the first in lexical order of bit position where several
+	// share a weight, and zero where there is none.
+	template<typename T, unsigned int SYNDROMES>
+	static constexpr CLookupTable<T, SYNDROMES> cosetLeaders(unsigned int length, unsigned int genpol, unsigned int degree, unsigned int maxWeight)
+	{
+		CLookupTable<T, SYNDROMES> table = {};
+		bool found[SYNDROMES] = {};
+
+		for (unsigned int weight = 0U; weight <= maxWeight; weight++) {
+			unsigned int pos[8U] = {};
+			for (unsigned int i = 0U; i < weight; i++)
+				pos[i] = i;
+
+			for (;;) {
+				unsigned int pattern = 0U;
+				for (unsigned int i = 0U; i < weight; i++)
+					pattern |= 1U << pos[i];
+
+				unsigned int syndrome = remainder(pattern, length, genpol, degree);
+				if (!found[syndrome]) {
+					table.m_value[syndrome] = T(pattern);
+					found[syndrome] = true;
+				}
+
+				// Step to the next set of bit positions
+				unsigned int i = weight;
+				while (i > 0U && pos[i - 1U] == length - weight + i - 1U)
+					i--;
+
+				if (i == 0U)
+					break;
+
+				pos[i - 1U]++;
+				for (unsigned int j = i; j < weight; j++)
+					pos[j] = pos[j - 1U] + 1U;
+			}
+		}
+
+		return table;
+	}
+
+	// For an MSB first CRC of width bits held at the top of a 16 bit register,
+	// the register after shifting in each value of its top byte
+	static constexpr CLookupTable<uint16_t, 256U> crcTable(unsigned int poly, unsigned int width)
+	{
+		CLookupTable<uint16_t, 256U> table = {};
+
+		unsigned int aligned = poly << (16U - width);
+		for (unsigned int n = 0U; n < 256U; n++) {
+			unsigned int crc = n << 8;
+			for (unsigned int i = 0U; i < 8U; i++)
+				crc = ((crc & 0x8000U) != 0U) ? ((crc << 1) ^ aligned) : (crc << 1);
+
+			table.m_value[n] = uint16_t(crc);
+		}
+
+		return table;
+	}
+
+	// FNV-1a, one step per value
+	static constexpr uint32_t hash(uint32_t h, uint32_t value)
+	{
+		return (h ^ value) * 16777619U;
+	}
+
+	template<typename T, unsigned int N>
+	static constexpr uint32_t hash(const CLookupTable<T, N>& table)
+	{
+		uint32_t h = 2166136261U;
+		for (unsigned int n = 0U; n < N; n++) {
+			h = hash(h, uint32_t(table.m_value[n]));
+
+			// Wider values take a second step for their upper half
+			if (sizeof(T) > 4U)
+				h = hash(h, uint32_t(uint64_t(table.m_value[n]) >> 32));
+		}
+
+		return h;
+	}
+};
+
+#endif
@@ -0,0 +1,125 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef FrameQueue_H
+#define FrameQueue_H
+
+#include "Log.h"
+
+#include <cstdio>
+#include <cassert>
+
+// A fixed size queue of whole frames, each push and pop moves one record
+template<class T> class CFrameQueue {
+public:
+	CFrameQueue(unsigned int length, const char* name) :
+	m_length(length),
+	m_name(name),
+	m_frames(NULL),
+	m_iPtr(0U),
+	m_oPtr(0U),
+	m_count(0U)
+	{
+		assert(length > 0U);
+		assert(name != NULL);
+
+		m_frames = new T[length];
+	}
+
+	~CFrameQueue()
+	{
+		delete[] m_frames;
+	}
+
+	bool push(const T& frame)
+	{
+		if (m_count == m_length) {
+			LogError("%s queue overflow, clearing the queue. (%u frames)", m_name, m_length);
+			clear();
+			return false;
+		}
+
+		m_frames[m_iPtr] = frame;
+
+		m_iPtr++;
+		if (m_iPtr == m_length)
+			m_iPtr = 0U;
+
+		m_count++;
+
+		return true;
+	}
+
+	bool pop(T& frame)
+	{
+		if (m_count == 0U) {
+			LogError("**** Underflow in %s queue", m_name);
+			return false;
+		}
+
+		frame = m_frames[m_oPtr];
+
+		m_oPtr++;
+		if (m_oPtr == m_length)
+			m_oPtr = 0U;
+
+		m_count--;
+
+		return true;
+	}
+
+	const T* peek() const
+	{
+		if (m_count == 0U)
+			return NULL;
+
+		return &m_frames[m_oPtr];
+	}
+
+	void clear()
+	{
+		m_iPtr  = 0U;
+		m_oPtr  = 0U;
+		m_count = 0U;
+	}
+
+	unsigned int size() const
+	{
+		return m_count;
+	}
+
+	unsigned int freeSpace() const
+	{
+		return m_length - m_count;
+	}
+
+	bool isEmpty() const
+	{
+		return m_count == 0U;
+	}
+
+private:
+	unsigned int m_length;
+	const char*  m_name;
+	T*           m_frames;
+	unsigned int m_iPtr;
+	unsigned int m_oPtr;
+	unsigned int m_count;
+};
+
+#endif
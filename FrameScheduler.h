@@ -0,0 +1,151 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#ifndef FrameScheduler_H
+#define FrameScheduler_H
+
+#include "FrameQueue.h"
+
+#include <cassert>
+#include <chrono>
+
+// A frame is late when it leaves more than this after its deadline
+const unsigned int SCHEDULER_LATE_MS = 5U;
+
+template<class T> class CDeparture {
+public:
+	T m_frame;
+	std::chrono::steady_clock::time_point m_deadline;
+};
+
+// Departure queue for the outgoing frames of one mode. Every frame added is
+// given an absolute deadline on a fixed grid of one frame period, started one
+// lead time after the first frame of a call, and is only returned by get()
+// once that deadline has been reached. The lead absorbs the uneven rate at
+// which the transcoder produces frames.
+template<class T> class CFrameScheduler {
+public:
+	CFrameScheduler(unsigned int period, unsigned int lead, unsigned int length, const char* name) :
+	m_period(std::chrono::milliseconds(period)),
+	m_lead(std::chrono::milliseconds(lead)),
+	m_queue(length, name),
+	m_started(false),
+	m_next(),
+	m_frames(0U),
+	m_misses(0U)
+	{
+		assert(period > 0U);
+	}
+
+	~CFrameScheduler()
+	{
+	}
+
+	bool add(const T& frame)
+	{
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+		if (!m_started) {
+			// A new call starts a new grid, but never before the previous call has left
+			if (m_next < now + m_lead)
+				m_next = now + m_lead;
+			m_started = true;
+		} else {
+			// Keep the phase and skip the slots that have gone, a frame that would
+			// leave late waits for the next slot rather than close up on the one before
+			while (m_next + std::chrono::milliseconds(SCHEDULER_LATE_MS) < now)
+				m_next += m_period;
+		}
+
+		CDeparture<T> departure;
+		departure.m_frame    = frame;
+		departure.m_deadline = m_next;
+
+		m_next += m_period;
+
+		return m_queue.push(departure);
+	}
+
+	bool get(T& frame)
+	{
+		const CDeparture<T>* head = m_queue.peek();
+		if (head == NULL)
+			return false;
+
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		if (now < head->m_deadline)
+			return false;
+
+		if (now - head->m_deadline > std::chrono::milliseconds(SCHEDULER_LATE_MS))
+			m_misses++;
+		m_frames++;
+
+		CDeparture<T> departure;
+		m_queue.pop(departure);
+
+		frame = departure.m_frame;
+
+		return true;
+	}
+
+	bool hasDeadline() const
+	{
+		return !m_queue.isEmpty();
+	}
+
+	std::chrono::steady_clock::time_point getDeadline() const
+	{
+		const CDeparture<T>* head = m_queue.peek();
+		assert(head != NULL);
+
+		return head->m_deadline;
+	}
+
+	// The next frame added will start a new grid
+	void reset()
+	{
+		m_started = false;
+	}
+
+	unsigned int getFrames() const
+	{
+		return m_frames;
+	}
+
+	unsigned int getMisses() const
+	{
+		return m_misses;
+	}
+
+	void clearStats()
+	{
+		m_frames = 0U;
+		m_misses = 0U;
+	}
+
+private:
+	std::chrono::steady_clock::duration   m_period;
+	std::chrono::steady_clock::duration   m_lead;
+	CFrameQueue< CDeparture<T> >          m_queue;
+	bool                                  m_started;
+	std::chrono::steady_clock::time_point m_next;
+	unsigned int                          m_frames;
+	unsigned int                          m_misses;
+};
+
+#endif
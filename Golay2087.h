@@ -19,12 +19,23 @@
 #ifndef Golay2087_H
 #define Golay2087_H
 
+#include "FECTables.h"
+
 class CGolay2087 {
 public:
 	static void encode(unsigned char* data);
 
 	static unsigned char decode(const unsigned char* data);
 
+	// The generator polynomial of the (19,8) code shortened from the (23,12) Golay code
+	static constexpr unsigned int GENERATOR = 0xC75U;
+
+	// The (20,8) code word of a data byte, the (19,8) code word followed by an even parity bit
+	static constexpr unsigned int codeword(unsigned int data)
+	{
+		return CFECTables::extend(CFECTables::codeword(data, 19U, GENERATOR, 11U));
+	}
+
 private:
 	static unsigned int getSyndrome1987(unsigned int pattern);
 };
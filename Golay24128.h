@@ -27,6 +27,13 @@ public:
 	static unsigned int decode23127(unsigned int code);
 	static unsigned int decode24128(unsigned int code);
 	static unsigned int decode24128(unsigned char* bytes);
+
+	// Batches of n words, the decoders return the number of bits corrected
+	static void encode23127(const unsigned int* data, unsigned int* codes, unsigned int n);
+	static void encode24128(const unsigned int* data, unsigned int* codes, unsigned int n);
+
+	static unsigned int decode23127(const unsigned int* codes, unsigned int* data, unsigned int n);
+	static unsigned int decode24128(const unsigned int* codes, unsigned int* data, unsigned int n);
 };
 
 #endif
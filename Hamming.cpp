@@ -21,6 +21,84 @@
 #include <cstdio>
 #include <cassert>
 
+// Each check covers its data bits and its own parity bit, the parity bits are the low bits of the word
+const unsigned int HAMMING15113_1_CHECKS[] = {0x7F08U, 0x78E4U, 0x66D2U, 0x55B1U};
+const unsigned int HAMMING15113_2_CHECKS[] = {0x7AC8U, 0x3D64U, 0x1EB2U, 0x7591U};
+const unsigned int HAMMING1393_CHECKS[]    = {0x1AC8U, 0x1D64U, 0x1EB2U, 0x1591U};
+const unsigned int HAMMING1063_CHECKS[]    = {0x0398U, 0x0354U, 0x02E2U, 0x01E1U};
+const unsigned int HAMMING16114_CHECKS[]   = {0xF590U, 0x7AC8U, 0x3D64U, 0xEB22U, 0xA6E1U};
+const unsigned int HAMMING17123_CHECKS[]   = {0x1E690U, 0x1F348U, 0x0F9A4U, 0x19A42U, 0x1CD21U};
+
+// The bit to flip for each syndrome, zero for no error or an uncorrectable one
+const unsigned int HAMMING15113_1_ERRORS[] = {
+	0x0000U, 0x0008U, 0x0004U, 0x0800U, 0x0002U, 0x0200U, 0x0040U, 0x2000U,
+	0x0001U, 0x0100U, 0x0020U, 0x1000U, 0x0010U, 0x0400U, 0x0080U, 0x4000U};
+
+const unsigned int HAMMING15113_2_ERRORS[] = {
+	0x0000U, 0x0008U, 0x0004U, 0x0040U, 0x0002U, 0x0200U, 0x0020U, 0x0800U,
+	0x0001U, 0x4000U, 0x0100U, 0x2000U, 0x0010U, 0x0080U, 0x0400U, 0x1000U};
+
+const unsigned int HAMMING1393_ERRORS[] = {
+	0x0000U, 0x0008U, 0x0004U, 0x0040U, 0x0002U, 0x0200U, 0x0020U, 0x0800U,
+	0x0001U, 0x0000U, 0x0100U, 0x0000U, 0x0010U, 0x0080U, 0x0400U, 0x1000U};
+
+const unsigned int HAMMING1063_ERRORS[] = {
+	0x0000U, 0x0008U, 0x0004U, 0x0010U, 0x0002U, 0x0000U, 0x0000U, 0x0200U,
+	0x0001U, 0x0000U, 0x0000U, 0x0100U, 0x0020U, 0x0080U, 0x0040U, 0x0000U};
+
+const unsigned int HAMMING16114_ERRORS[] = {
+	0x0000U, 0x0010U, 0x0008U, 0x0000U, 0x0004U, 0x0000U, 0x0000U, 0x1000U,
+	0x0002U, 0x0000U, 0x0000U, 0x4000U, 0x0000U, 0x0100U, 0x0800U, 0x0000U,
+	0x0001U, 0x0000U, 0x0000U, 0x0080U, 0x0000U, 0x0400U, 0x0040U, 0x0000U,
+	0x0000U, 0x8000U, 0x0200U, 0x0000U, 0x0020U, 0x0000U, 0x0000U, 0x2000U};
+
+const unsigned int HAMMING17123_ERRORS[] = {
+	0x00000U, 0x00010U, 0x00008U, 0x00000U, 0x00004U, 0x00080U, 0x00000U, 0x02000U,
+	0x00002U, 0x00000U, 0x00040U, 0x00200U, 0x00000U, 0x00000U, 0x01000U, 0x00000U,
+	0x00001U, 0x00400U, 0x00000U, 0x00000U, 0x00020U, 0x00000U, 0x00100U, 0x04000U,
+	0x00000U, 0x00000U, 0x00000U, 0x10000U, 0x00800U, 0x00000U, 0x00000U, 0x08000U};
+
+static unsigned int parity(unsigned int v)
+{
+#if defined(__GNUC__)
+	return (unsigned int)__builtin_parity(v);
+#else
+	v ^= v >> 16;
+	v ^= v >> 8;
+	v ^= v >> 4;
+	v ^= v >> 2;
+	v ^= v >> 1;
+
+	return v & 0x01U;
+#endif
+}
+
+static unsigned int syndrome(unsigned int d, const unsigned int* checks, unsigned int n)
+{
+	unsigned int s = 0U;
+	for (unsigned int k = 0U; k < n; k++)
+		s |= parity(d & checks[k]) << k;
+
+	return s;
+}
+
+static unsigned int errorWord(unsigned int d, const unsigned int* checks, const unsigned int* errors, unsigned int n, unsigned int& s)
+{
+	s = syndrome(d, checks, n);
+
+	return errors[s];
+}
+
+static unsigned int encodeWord(unsigned int d, const unsigned int* checks, unsigned int n)
+{
+	d &= ~((1U << n) - 1U);
+
+	for (unsigned int k = 0U; k < n; k++)
+		d |= parity(d & checks[k]) << (n - 1U - k);
+
+	return d;
+}
+
  // Hamming (15,11,3) check a boolean data array
 bool CHamming::decode15113_1(bool* d)
 {
@@ -347,3 +425,117 @@ void CHamming::encode17123(bool* d)
 	d[15] = d[0] ^ d[1] ^ d[4] ^ d[5] ^ d[7] ^ d[10];
 	d[16] = d[0] ^ d[1] ^ d[2] ^ d[5] ^ d[6] ^ d[8] ^ d[11];
 }
+
+unsigned int CHamming::encode15113_1(unsigned int d)
+{
+	return encodeWord(d, HAMMING15113_1_CHECKS, 4U);
+}
+
+bool CHamming::decode15113_1(unsigned int& d)
+{
+	unsigned int s;
+	unsigned int error = errorWord(d, HAMMING15113_1_CHECKS, HAMMING15113_1_ERRORS, 4U, s);
+	if (error == 0U)
+		return false;
+
+	d ^= error;
+
+	return true;
+}
+
+unsigned int CHamming::encode15113_2(unsigned int d)
+{
+	return encodeWord(d, HAMMING15113_2_CHECKS, 4U);
+}
+
+bool CHamming::decode15113_2(unsigned int& d)
+{
+	unsigned int s;
+	unsigned int error = errorWord(d, HAMMING15113_2_CHECKS, HAMMING15113_2_ERRORS, 4U, s);
+	if (error == 0U)
+		return false;
+
+	d ^= error;
+
+	return true;
+}
+
+unsigned int CHamming::encode1393(unsigned int d)
+{
+	return encodeWord(d, HAMMING1393_CHECKS, 4U);
+}
+
+bool CHamming::decode1393(unsigned int& d)
+{
+	unsigned int s;
+	unsigned int error = errorWord(d, HAMMING1393_CHECKS, HAMMING1393_ERRORS, 4U, s);
+	if (error == 0U)
+		return false;
+
+	d ^= error;
+
+	return true;
+}
+
+unsigned int CHamming::encode1063(unsigned int d)
+{
+	return encodeWord(d, HAMMING1063_CHECKS, 4U);
+}
+
+bool CHamming::decode1063(unsigned int& d)
+{
+	unsigned int s;
+	unsigned int error = errorWord(d, HAMMING1063_CHECKS, HAMMING1063_ERRORS, 4U, s);
+	if (error == 0U)
+		return false;
+
+	d ^= error;
+
+	return true;
+}
+
+unsigned int CHamming::encode16114(unsigned int d)
+{
+	return encodeWord(d, HAMMING16114_CHECKS, 5U);
+}
+
+bool CHamming::decode16114(unsigned int& d)
+{
+	unsigned int s;
+	unsigned int error = errorWord(d, HAMMING16114_CHECKS, HAMMING16114_ERRORS, 5U, s);
+
+	// No bit errors
+	if (s == 0U)
+		return true;
+
+	// Unrecoverable errors
+	if (error == 0U)
+		return false;
+
+	d ^= error;
+
+	return true;
+}
+
+unsigned int CHamming::encode17123(unsigned int d)
+{
+	return encodeWord(d, HAMMING17123_CHECKS, 5U);
+}
+
+bool CHamming::decode17123(unsigned int& d)
+{
+	unsigned int s;
+	unsigned int error = errorWord(d, HAMMING17123_CHECKS, HAMMING17123_ERRORS, 5U, s);
+
+	// No bit errors
+	if (s == 0U)
+		return true;
+
+	// Unrecoverable errors
+	if (error == 0U)
+		return false;
+
+	d ^= error;
+
+	return true;
+}
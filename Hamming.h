@@ -38,6 +38,25 @@ public:
 
 	static void encode17123(bool* d);
 	static bool decode17123(bool* d);
+
+	// The same codes on packed words, d[0] is the most significant of the n bits
+	static unsigned int encode15113_1(unsigned int d);
+	static bool decode15113_1(unsigned int& d);
+
+	static unsigned int encode15113_2(unsigned int d);
+	static bool decode15113_2(unsigned int& d);
+
+	static unsigned int encode1393(unsigned int d);
+	static bool decode1393(unsigned int& d);
+
+	static unsigned int encode1063(unsigned int d);
+	static bool decode1063(unsigned int& d);
+
+	static unsigned int encode16114(unsigned int d);
+	static bool decode16114(unsigned int& d);
+
+	static unsigned int encode17123(unsigned int d);
+	static bool decode17123(unsigned int& d);
 };
 
 #endif
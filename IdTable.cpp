@@ -0,0 +1,491 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "IdTable.h"
+#include "FECTables.h"
+
+#if defined(_WIN32) || defined(_WIN64)
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+const char         INDEX_MAGIC[]    = "IDINDEX";
+const unsigned int INDEX_VERSION    = 2U;
+const uint32_t     INDEX_BYTE_ORDER = 0x01020304U;
+
+// An index is this header followed by the Ids, the records in callsign order, and the records
+struct CIndexHeader {
+	char     m_magic[8U];
+	uint32_t m_version;
+	uint32_t m_byteOrder;
+	uint32_t m_count;
+	uint32_t m_lines;
+	uint32_t m_names;
+	uint32_t m_checksum;
+	uint64_t m_sourceSize;
+	int64_t  m_sourceTime;
+};
+
+static_assert(sizeof(CIndexHeader) == 48U, "The index header has padding");
+
+static uint32_t checksum(const uint32_t* ids, unsigned int lines, const uint32_t* names, unsigned int count, const char* records)
+{
+	uint32_t h = 2166136261U;
+
+	for (unsigned int n = 0U; n < lines; n++)
+		h = CFECTables::hash(h, ids[n]);
+
+	for (unsigned int n = 0U; n < count; n++)
+		h = CFECTables::hash(h, names[n]);
+
+	for (unsigned int n = 0U; n < lines * ID_CALLSIGN_LENGTH; n += 4U) {
+		uint32_t word;
+		::memcpy(&word, records + n, 4U);
+		h = CFECTables::hash(h, word);
+	}
+
+	return h;
+}
+
+// A callsign record compares as two words, in the order memcmp would give
+static uint64_t readKey(const char* text)
+{
+	const unsigned char* p = (const unsigned char*)text;
+
+	return (uint64_t(p[0U]) << 56) | (uint64_t(p[1U]) << 48) | (uint64_t(p[2U]) << 40) | (uint64_t(p[3U]) << 32) |
+	       (uint64_t(p[4U]) << 24) | (uint64_t(p[5U]) << 16) | (uint64_t(p[6U]) << 8)  | uint64_t(p[7U]);
+}
+
+// The first entry for which less() is false. The steps are branch free, a
+// mispredicted branch at every level costs more than the search's loads.
+template<typename F> static const uint32_t* lowerBound(const uint32_t* base, unsigned int n, F less)
+{
+	if (n == 0U)
+		return base;
+
+	while (n > 1U) {
+		unsigned int half = n / 2U;
+		base = less(base[half]) ? base + half : base;
+		n -= half;
+	}
+
+	return less(*base) ? base + 1U : base;
+}
+
+CIdTable::CIdTable() :
+m_callsigns(),
+m_ids(),
+m_byCallsign(),
+m_count(0U),
+m_lines(0U),
+m_names(0U),
+m_records(NULL),
+m_idList(NULL),
+m_nameList(NULL),
+m_mapping(NULL),
+m_length(0U)
+{
+}
+
+CIdTable::~CIdTable()
+{
+	unmap();
+}
+
+bool CIdTable::add(unsigned int id, const char* callsign)
+{
+	assert(callsign != NULL);
+	assert(m_mapping == NULL);
+
+	size_t length = ::strlen(callsign);
+	if (length >= ID_CALLSIGN_LENGTH)
+		return false;
+
+	size_t pos = m_callsigns.size();
+	m_callsigns.resize(pos + ID_CALLSIGN_LENGTH, 0x00);
+	::memcpy(&m_callsigns[pos], callsign, length);
+
+	m_ids.push_back(id);
+
+	return true;
+}
+
+// Until sorted the records are in file order, afterwards the winner for each Id
+// comes first in Id order followed by the callsigns of the replaced Ids
+void CIdTable::sort()
+{
+	assert(m_mapping == NULL);
+
+	unsigned int lines = (unsigned int)m_ids.size();
+
+	std::vector<uint32_t> order(lines);
+	for (unsigned int n = 0U; n < lines; n++)
+		order[n] = n;
+
+	const char* records = m_callsigns.data();
+	auto line = [records](uint32_t n) {
+		return records + n * ID_CALLSIGN_LENGTH;
+	};
+
+	// File order within each callsign is kept, so the last line for a callsign is the last of its run
+	std::stable_sort(order.begin(), order.end(), [line](uint32_t a, uint32_t b) {
+		return ::memcmp(line(a), line(b), ID_CALLSIGN_LENGTH) < 0;
+	});
+
+	std::vector<uint32_t> byCallsign;
+	for (unsigned int n = 0U; n < lines; n++) {
+		if (n + 1U == lines || ::memcmp(line(order[n]), line(order[n + 1U]), ID_CALLSIGN_LENGTH) != 0)
+			byCallsign.push_back(order[n]);
+	}
+
+	byCallsign.shrink_to_fit();
+
+	for (unsigned int n = 0U; n < lines; n++)
+		order[n] = n;
+
+	std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b) {
+		return m_ids[a] < m_ids[b];
+	});
+
+	std::vector<uint32_t> position(lines);
+	std::vector<uint32_t> replaced;
+	unsigned int count = 0U;
+	for (unsigned int n = 0U; n < lines; n++) {
+		if (n + 1U == lines || m_ids[order[n]] != m_ids[order[n + 1U]])
+			order[count++] = order[n];
+		else
+			replaced.push_back(order[n]);
+	}
+
+	order.resize(count);
+	order.insert(order.end(), replaced.begin(), replaced.end());
+
+	std::vector<char>     callsigns(lines * ID_CALLSIGN_LENGTH);
+	std::vector<uint32_t> ids(lines);
+	for (unsigned int n = 0U; n < lines; n++) {
+		::memcpy(&callsigns[n * ID_CALLSIGN_LENGTH], line(order[n]), ID_CALLSIGN_LENGTH);
+		ids[n] = m_ids[order[n]];
+		position[order[n]] = n;
+	}
+
+	for (unsigned int n = 0U; n < byCallsign.size(); n++)
+		byCallsign[n] = position[byCallsign[n]];
+
+	m_callsigns.swap(callsigns);
+	m_ids.swap(ids);
+	m_byCallsign.swap(byCallsign);
+	m_count = count;
+
+	m_lines    = lines;
+	m_names    = (unsigned int)m_byCallsign.size();
+	m_records  = m_callsigns.data();
+	m_idList   = m_ids.data();
+	m_nameList = m_byCallsign.data();
+}
+
+bool CIdTable::save(const std::string& index, uint64_t sourceSize, int64_t sourceTime) const
+{
+	CIndexHeader header;
+	::memset(&header, 0x00, sizeof(CIndexHeader));
+	::memcpy(header.m_magic, INDEX_MAGIC, sizeof(INDEX_MAGIC));
+	header.m_version   = INDEX_VERSION;
+	header.m_byteOrder = INDEX_BYTE_ORDER;
+	header.m_count     = m_count;
+	header.m_lines     = m_lines;
+	header.m_names     = m_names;
+	header.m_checksum  = checksum(m_idList, m_lines, m_nameList, m_names, m_records);
+	header.m_sourceSize = sourceSize;
+	header.m_sourceTime = sourceTime;
+
+	// Written under a name of its own so that processes compiling at the same time do not mix their output
+	char suffix[20U];
+#if defined(_WIN32) || defined(_WIN64)
+	::sprintf(suffix, ".%lu", (unsigned long)::GetCurrentProcessId());
+#else
+	::sprintf(suffix, ".%ld", (long)::getpid());
+#endif
+	std::string temporary = index + suffix;
+
+	FILE* fp = ::fopen(temporary.c_str(), "wb");
+	if (fp == NULL)
+		return false;
+
+	bool ok = ::fwrite(&header, sizeof(CIndexHeader), 1U, fp) == 1U;
+	if (ok && m_lines > 0U)
+		ok = ::fwrite(m_idList, sizeof(uint32_t), m_lines, fp) == m_lines &&
+			 ::fwrite(m_nameList, sizeof(uint32_t), m_names, fp) == m_names &&
+			 ::fwrite(m_records, ID_CALLSIGN_LENGTH, m_lines, fp) == m_lines;
+
+	if (::fclose(fp) != 0)
+		ok = false;
+
+#if defined(_WIN32) || defined(_WIN64)
+	if (ok)
+		ok = ::MoveFileExA(temporary.c_str(), index.c_str(), MOVEFILE_REPLACE_EXISTING) != 0;
+#else
+	if (ok)
+		ok = ::rename(temporary.c_str(), index.c_str()) == 0;
+#endif
+
+	if (!ok)
+		::remove(temporary.c_str());
+
+	return ok;
+}
+
+bool CIdTable::map(const std::string& index, const std::string& source)
+{
+	unmap();
+
+#if defined(_WIN32) || defined(_WIN64)
+	HANDLE file = ::CreateFileA(index.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER length;
+	if (!::GetFileSizeEx(file, &length) || length.QuadPart < LONGLONG(sizeof(CIndexHeader))) {
+		::CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0U, 0U, NULL);
+	::CloseHandle(file);
+	if (mapping == NULL)
+		return false;
+
+	// The view keeps the mapping open
+	void* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0U, 0U, 0U);
+	::CloseHandle(mapping);
+	if (view == NULL)
+		return false;
+
+	m_mapping = view;
+	m_length  = size_t(length.QuadPart);
+#else
+	int fd = ::open(index.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat info;
+	if (::fstat(fd, &info) != 0 || info.st_size < off_t(sizeof(CIndexHeader))) {
+		::close(fd);
+		return false;
+	}
+
+	// The mapping keeps the file open
+	void* view = ::mmap(NULL, size_t(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (view == MAP_FAILED)
+		return false;
+
+	m_mapping = view;
+	m_length  = size_t(info.st_size);
+#endif
+
+	const char* base = (const char*)m_mapping;
+
+	CIndexHeader header;
+	::memcpy(&header, base, sizeof(CIndexHeader));
+
+	// A missing source leaves the index as the only copy, so it is not treated as stale
+	uint64_t sourceSize;
+	int64_t  sourceTime;
+	bool sourceExists = getSource(source, sourceSize, sourceTime);
+
+	bool ok = ::memcmp(header.m_magic, INDEX_MAGIC, sizeof(INDEX_MAGIC)) == 0 &&
+			  header.m_version == INDEX_VERSION && header.m_byteOrder == INDEX_BYTE_ORDER &&
+			  header.m_count <= header.m_lines && header.m_names <= header.m_lines &&
+			  m_length == sizeof(CIndexHeader) + (uint64_t(header.m_lines) + header.m_names) * sizeof(uint32_t) + uint64_t(header.m_lines) * ID_CALLSIGN_LENGTH;
+
+	if (ok && sourceExists)
+		ok = header.m_sourceSize == sourceSize && header.m_sourceTime == sourceTime;
+
+	if (!ok) {
+		unmap();
+		return false;
+	}
+
+	const uint32_t* ids     = (const uint32_t*)(base + sizeof(CIndexHeader));
+	const uint32_t* names   = ids + header.m_lines;
+	const char*     records = (const char*)(names + header.m_names);
+
+	ok = checksum(ids, header.m_lines, names, header.m_names, records) == header.m_checksum;
+
+	// Damage the checksum misses must still not send a lookup outside the mapping
+	for (unsigned int n = 0U; ok && n < header.m_names; n++)
+		ok = names[n] < header.m_lines;
+
+	for (unsigned int n = 0U; ok && n < header.m_lines; n++)
+		ok = records[n * ID_CALLSIGN_LENGTH + ID_CALLSIGN_LENGTH - 1U] == 0x00;
+
+	if (!ok) {
+		unmap();
+		return false;
+	}
+
+	m_count    = header.m_count;
+	m_lines    = header.m_lines;
+	m_names    = header.m_names;
+	m_records  = records;
+	m_idList   = ids;
+	m_nameList = names;
+
+	return true;
+}
+
+const char* CIdTable::findCS(unsigned int id) const
+{
+	const uint32_t* end = m_idList + m_count;
+	const uint32_t* it  = lowerBound(m_idList, m_count, [id](uint32_t n) {
+		return n < id;
+	});
+	if (it == end || *it != id)
+		return NULL;
+
+	return record((unsigned int)(it - m_idList));
+}
+
+unsigned int CIdTable::findID(const char* callsign) const
+{
+	assert(callsign != NULL);
+
+	size_t length = ::strlen(callsign);
+	if (length >= ID_CALLSIGN_LENGTH)
+		return 0U;
+
+	char key[ID_CALLSIGN_LENGTH];
+	::memset(key, 0x00, ID_CALLSIGN_LENGTH);
+	::memcpy(key, callsign, length);
+
+	uint64_t high = readKey(key);
+	uint64_t low  = readKey(key + 8U);
+
+	// The search goes by the first eight characters, callsigns sharing them are few and stepped through
+	const uint32_t* end = m_nameList + m_names;
+	const uint32_t* it  = lowerBound(m_nameList, m_names, [this, high](uint32_t n) {
+		return readKey(record(n)) < high;
+	});
+
+	while (it != end && readKey(record(*it)) == high && readKey(record(*it) + 8U) < low)
+		it++;
+
+	if (it == end || ::memcmp(record(*it), key, ID_CALLSIGN_LENGTH) != 0)
+		return 0U;
+
+	return m_idList[*it];
+}
+
+bool CIdTable::exists(unsigned int id) const
+{
+	return findCS(id) != NULL;
+}
+
+bool CIdTable::isMapped() const
+{
+	return m_mapping != NULL;
+}
+
+unsigned int CIdTable::size() const
+{
+	return m_count;
+}
+
+unsigned int CIdTable::memory() const
+{
+	if (m_mapping != NULL)
+		return (unsigned int)m_length;
+
+	return (unsigned int)(m_callsigns.capacity() + (m_ids.capacity() + m_byCallsign.capacity()) * sizeof(uint32_t));
+}
+
+void CIdTable::toDecimal(unsigned int id, char* text)
+{
+	assert(text != NULL);
+
+	char digits[10U];
+	unsigned int n = 0U;
+	do {
+		digits[n++] = char('0' + id % 10U);
+		id /= 10U;
+	} while (id > 0U);
+
+	while (n > 0U)
+		*text++ = digits[--n];
+
+	*text = 0x00;
+}
+
+// Windows only gives the time to the second here
+bool CIdTable::getSource(const std::string& source, uint64_t& size, int64_t& time)
+{
+	size = 0U;
+	time = 0;
+
+	struct stat info;
+	if (::stat(source.c_str(), &info) != 0)
+		return false;
+
+	size = uint64_t(info.st_size);
+#if defined(_WIN32) || defined(_WIN64)
+	time = int64_t(info.st_mtime) * 1000000000LL;
+#elif defined(__APPLE__)
+	time = int64_t(info.st_mtimespec.tv_sec) * 1000000000LL + info.st_mtimespec.tv_nsec;
+#else
+	time = int64_t(info.st_mtim.tv_sec) * 1000000000LL + info.st_mtim.tv_nsec;
+#endif
+
+	return true;
+}
+
+const char* CIdTable::record(unsigned int n) const
+{
+	return m_records + n * ID_CALLSIGN_LENGTH;
+}
+
+void CIdTable::unmap()
+{
+	if (m_mapping == NULL)
+		return;
+
+#if defined(_WIN32) || defined(_WIN64)
+	::UnmapViewOfFile(m_mapping);
+#else
+	::munmap(m_mapping, m_length);
+#endif
+
+	m_mapping  = NULL;
+	m_length   = 0U;
+	m_count    = 0U;
+	m_lines    = 0U;
+	m_names    = 0U;
+	m_records  = NULL;
+	m_idList   = NULL;
+	m_nameList = NULL;
+}
@@ -0,0 +1,94 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(IDTABLE_H)
+#define	IDTABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Room for a callsign and its terminating NUL, or an Id in decimal
+const unsigned int ID_CALLSIGN_LENGTH = 16U;
+
+// The Id to callsign mappings of one load of a lookup file, read only once
+// sorted. The callsigns are fixed length records in one arena, in Id order,
+// with the Ids in a parallel sorted array and a second index of the records
+// in callsign order. Where a line repeats an Id or a callsign the last one
+// wins, the callsign of a replaced Id is kept for the reverse lookup only.
+//
+// A sorted table can be saved as a binary index and mapped back read only,
+// so every process using the same index shares one copy of its pages. The
+// index records the size and modification time, to the nanosecond where the
+// system keeps it, of the lookup file it was compiled from and a checksum of
+// its contents. It is only mapped while the file is missing or unchanged, and
+// while the checksum matches.
+class CIdTable {
+public:
+	CIdTable();
+	~CIdTable();
+
+	// Callsigns too long for a record are rejected
+	bool add(unsigned int id, const char* callsign);
+
+	void sort();
+
+	// Replaces the index atomically, the mappings of the old one stay valid. The
+	// size and time are those of the source as it was before it was parsed, so
+	// that a change made while parsing leaves the index stale
+	bool save(const std::string& index, uint64_t sourceSize, int64_t sourceTime) const;
+
+	// Fails when the index is missing, damaged, or older than the source
+	bool map(const std::string& index, const std::string& source);
+
+	// Points into the table, valid for as long as the table is
+	const char* findCS(unsigned int id) const;
+	unsigned int findID(const char* callsign) const;
+
+	bool exists(unsigned int id) const;
+
+	bool isMapped() const;
+
+	unsigned int size() const;
+	unsigned int memory() const;
+
+	static void toDecimal(unsigned int id, char* text);
+
+	// The size and modification time in nanoseconds of a source, false when it is missing
+	static bool getSource(const std::string& source, uint64_t& size, int64_t& time);
+
+private:
+	std::vector<char>     m_callsigns;
+	std::vector<uint32_t> m_ids;
+	std::vector<uint32_t> m_byCallsign;
+	unsigned int          m_count;
+	unsigned int          m_lines;
+	unsigned int          m_names;
+	const char*           m_records;
+	const uint32_t*       m_idList;
+	const uint32_t*       m_nameList;
+	void*                 m_mapping;
+	size_t                m_length;
+
+	const char* record(unsigned int n) const;
+	void unmap();
+};
+
+#endif
@@ -17,6 +17,7 @@
  */
 
 #include "Log.h"
+#include "Mutex.h"
 
 #if defined(_WIN32) || defined(_WIN64)
 #include <Windows.h>
@@ -41,6 +42,9 @@ static unsigned int m_displayLevel = 2U;
 
 static struct tm m_tm;
 
+// Serialises the formatting and output when more than one thread logs
+static CMutex m_mutex;
+
 static char LEVELS[] = " DMIWEF";
 
 static bool LogOpen()
@@ -93,6 +97,8 @@ void Log(unsigned int level, const char* fmt, ...)
 {
     assert(fmt != NULL);
 
+	m_mutex.lock();
+
 	char buffer[300U];
 #if defined(_WIN32) || defined(_WIN64)
 	SYSTEMTIME st;
@@ -117,8 +123,10 @@ void Log(unsigned int level, const char* fmt, ...)
 
 	if (level >= m_fileLevel && m_fileLevel != 0U) {
 		bool ret = ::LogOpen();
-		if (!ret)
+		if (!ret) {
+			m_mutex.unlock();
 			return;
+		}
 
 		::fprintf(m_fpLog, "%s\n", buffer);
 		::fflush(m_fpLog);
@@ -133,4 +141,6 @@ void Log(unsigned int level, const char* fmt, ...)
         ::fclose(m_fpLog);
         exit(1);
     }
+
+	m_mutex.unlock();
 }
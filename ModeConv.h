@@ -18,11 +18,19 @@
  */
 
 #include "Defines.h"
-#include "RingBuffer.h"
+#include "FrameQueue.h"
+
+#include <cstdint>
 
 #if !defined(MODECONV_H)
 #define MODECONV_H
 
+class CAMBEFrame {
+public:
+	unsigned char m_tag;
+	unsigned char m_ambe[9U];
+};
+
 class CModeConv {
 public:
 	CModeConv();
@@ -39,13 +47,20 @@ public:
 	unsigned int getNXDN(unsigned char* data);
 	unsigned int getDMR(unsigned char* data);
 
+	unsigned int getDMRErrors() const;
+	unsigned int getDMRBits() const;
+
+	static const char* getKernel();
+
 private:
-	unsigned int m_nxdnN;
-	unsigned int m_dmrN;
-	CRingBuffer<unsigned char> m_NXDN;
-	CRingBuffer<unsigned char> m_DMR;
-	void encode(const unsigned char* in, unsigned char* out, unsigned int offset) const;
-	void decode(const unsigned char* in, unsigned char* out, unsigned int offset) const;
+	unsigned int m_dmrErrs;
+	unsigned int m_dmrBits;
+	CFrameQueue<CAMBEFrame> m_NXDN;
+	CFrameQueue<CAMBEFrame> m_DMR;
+	void putField(uint64_t field);
+	void putFrame(CFrameQueue<CAMBEFrame>& queue, unsigned char tag, const unsigned char* ambe);
+	void encode(const uint64_t* fields, unsigned char* out, unsigned int n) const;
+	unsigned int decode(const unsigned char* in, uint64_t* fields, unsigned int n) const;
 };
 
 #endif
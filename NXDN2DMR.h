@@ -20,35 +20,20 @@
 #if !defined(NXDN2DMR_H)
 #define NXDN2DMR_H
 
-#include "DMRDefines.h"
-#include "NXDNDefines.h"
-#include "ModeConv.h"
-#include "DMRNetwork.h"
-#include "DMREmbeddedData.h"
-#include "DMRLC.h"
-#include "DMRFullLC.h"
-#include "DMREMB.h"
+#include "Bridge.h"
 #include "DMRLookup.h"
-#include "NXDNConvolution.h"
-#include "NXDNCRC.h"
-#include "NXDNLayer3.h"
-#include "NXDNLICH.h"
 #include "NXDNLookup.h"
-#include "NXDNSACCH.h"
-#include "NXDNNetwork.h"
 #include "Reflectors.h"
-#include "UDPSocket.h"
+#include "Reactor.h"
 #include "StopWatch.h"
 #include "Version.h"
 #include "Thread.h"
-#include "Timer.h"
-#include "Sync.h"
-#include "Utils.h"
 #include "Conf.h"
 #include "Log.h"
-#include "CRC.h"
 
 #include <string>
+#include <vector>
+#include <functional>
 
 enum TG_STATUS {
 	NONE,
@@ -57,6 +42,25 @@ enum TG_STATUS {
 	SEND_PTT
 };
 
+// Runs one stage of a threaded bridge, or one worker of the host
+class CStageThread : public CThread {
+public:
+	CStageThread(const std::function<void()>& loop) :
+	m_loop(loop)
+	{
+	}
+
+	virtual void entry()
+	{
+		m_loop();
+	}
+
+private:
+	std::function<void()> m_loop;
+};
+
+// Hosts the bridges of one configuration file. The id lookups, the XLX
+// reflector list and the log are loaded once and shared by every bridge.
 class CNXDN2DMR
 {
 public:
@@ -66,42 +70,15 @@ public:
 	int run();
 
 private:
-	std::string      m_callsign;
-	unsigned int     m_nxdnTG;
-	CConf            m_conf;
-	CDMRNetwork*     m_dmrNetwork;
-	CNXDNNetwork*    m_nxdnNetwork;
-	CDMRLookup*      m_dmrlookup;
-	CNXDNLookup*     m_nxdnlookup;
-	CModeConv        m_conv;
-	unsigned int     m_colorcode;
-	unsigned int     m_srcHS;
-	unsigned int     m_defsrcid;
-	unsigned int     m_dstid;
-	bool             m_dmrpc;
-	unsigned int     m_dmrSrc;
-	unsigned int     m_dmrDst;
-	unsigned int     m_nxdnSrc;
-	unsigned int     m_nxdnDst;
-	unsigned char    m_dmrLastDT;
-	unsigned char    m_nxdnFrame[200U];
-	unsigned char    m_dmrFrame[50U];
-	unsigned int     m_dmrFrames;
-	unsigned int     m_nxdnFrames;
-	CDMREmbeddedData m_EmbeddedLC;
-	FLCO             m_dmrflco;
-	bool             m_dmrinfo;
-	bool             m_nxdninfo;
-	std::string      m_xlxmodule;
-	bool             m_xlxConnected;
-	CReflectors*     m_xlxReflectors;
-	unsigned int     m_xlxrefl;
+	CConf                 m_conf;
+	CDMRLookup*           m_dmrlookup;
+	CNXDNLookup*          m_nxdnlookup;
+	CReflectors*          m_xlxReflectors;
+	std::vector<CBridge*> m_bridges;
 
-	bool createDMRNetwork();
-	unsigned int findNXDNID(unsigned int dmrid);
-	unsigned int findDMRID(unsigned int nxdnid);
-	unsigned int truncID(unsigned int id);
-	void writeXLXLink(unsigned int srcId, unsigned int dstId, CDMRNetwork* network);
+	bool runThreads(CBridge* bridge);
+	bool runWorkers();
+	void runWorker(const std::vector<CBridge*>& bridges, CReactor& reactor, bool housekeeping);
 };
 
 #endif
@@ -17,169 +17,132 @@
  */
 
 #include "NXDNCRC.h"
+#include "FECTables.h"
 
 #include <cstdio>
 #include <cassert>
 
 const uint8_t  BIT_MASK_TABLE1[] = { 0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U };
 
-#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE1[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE1[(i)&7])
 #define READ_BIT1(p,i)    (p[(i)>>3] & BIT_MASK_TABLE1[(i)&7])
 
-bool CNXDNCRC::checkCRC6(const unsigned char* in, unsigned int length)
+const unsigned int CRC6_POLY  = 0x27U;
+const unsigned int CRC12_POLY = 0x080FU;
+const unsigned int CRC15_POLY = 0x4CC5U;
+
+// Each CRC register is held MSB aligned in 16 bits so that one byte of input
+// is a single lookup, the table entry is the register after shifting in the
+// top byte with the polynomial aligned the same way.
+static constexpr CLookupTable<uint16_t, 256U> CRC6_TABLE  = CFECTables::crcTable(CRC6_POLY, 6U);
+static constexpr CLookupTable<uint16_t, 256U> CRC12_TABLE = CFECTables::crcTable(CRC12_POLY, 12U);
+static constexpr CLookupTable<uint16_t, 256U> CRC15_TABLE = CFECTables::crcTable(CRC15_POLY, 15U);
+
+static_assert(CFECTables::hash(CRC6_TABLE)  == 0x3E1789C5U, "CRC6 table mismatch");
+static_assert(CFECTables::hash(CRC12_TABLE) == 0x3C50B9C5U, "CRC12 table mismatch");
+static_assert(CFECTables::hash(CRC15_TABLE) == 0x137FA4C5U, "CRC15 table mismatch");
+
+static uint16_t createCRC(const CLookupTable<uint16_t, 256U>& table, uint16_t poly, uint16_t crc, const unsigned char* in, unsigned int length)
 {
-	assert(in != NULL);
+	unsigned int n = length >> 3;
+	for (unsigned int i = 0U; i < n; i++)
+		crc = (crc << 8) ^ table[(crc >> 8) ^ in[i]];
+
+	// Any bits after the last whole byte
+	for (unsigned int i = n * 8U; i < length; i++) {
+		bool bit1 = READ_BIT1(in, i) != 0x00U;
+		bool bit2 = (crc & 0x8000U) == 0x8000U;
 
-	uint8_t crc = createCRC6(in, length);
+		crc <<= 1;
 
-	uint8_t temp[1U];
-	temp[0U] = 0x00U;
-	unsigned int j = length;
-	for (unsigned int i = 2U; i < 8U; i++, j++) {
-		bool b = READ_BIT1(in, j);
-		WRITE_BIT1(temp, i, b);
+		if (bit1 ^ bit2)
+			crc ^= poly;
 	}
 
-	return crc == temp[0U];
+	return crc;
 }
 
-void CNXDNCRC::encodeCRC6(unsigned char* in, unsigned int length)
+// Read or write up to 16 bits starting at any bit position
+static unsigned int readBits(const unsigned char* in, unsigned int pos, unsigned int n)
 {
-	assert(in != NULL);
+	unsigned int first = pos >> 3;
+	unsigned int count = ((pos & 0x07U) + n + 7U) >> 3;
+
+	unsigned int value = 0U;
+	for (unsigned int i = 0U; i < count; i++)
+		value = (value << 8) | in[first + i];
+
+	return (value >> (count * 8U - (pos & 0x07U) - n)) & ((1U << n) - 1U);
+}
+
+static void writeBits(unsigned char* in, unsigned int pos, unsigned int n, unsigned int value)
+{
+	unsigned int first = pos >> 3;
+	unsigned int count = ((pos & 0x07U) + n + 7U) >> 3;
+	unsigned int shift = count * 8U - (pos & 0x07U) - n;
 
-	uint8_t crc[1U];
-	crc[0U] = createCRC6(in, length);
+	unsigned int mask = ((1U << n) - 1U) << shift;
+	value = (value << shift) & mask;
 
-	unsigned int n = length;
-	for (unsigned int i = 2U; i < 8U; i++, n++) {
-		bool b = READ_BIT1(crc, i);
-		WRITE_BIT1(in, n, b);
+	for (unsigned int i = 0U; i < count; i++) {
+		unsigned int s = (count - 1U - i) * 8U;
+		in[first + i] = (in[first + i] & ~(mask >> s)) | (value >> s);
 	}
 }
 
-bool CNXDNCRC::checkCRC12(const unsigned char* in, unsigned int length)
+
+bool CNXDNCRC::checkCRC6(const unsigned char* in, unsigned int length)
 {
 	assert(in != NULL);
 
-	uint16_t crc = createCRC12(in, length);
-	uint8_t temp1[2U];
-	temp1[0U] = (crc >> 8) & 0xFFU;
-	temp1[1U] = (crc >> 0) & 0xFFU;
-
-	uint8_t temp2[2U];
-	temp2[0U] = 0x00U;
-	temp2[1U] = 0x00U;
-	unsigned int j = length;
-	for (unsigned int i = 4U; i < 16U; i++, j++) {
-		bool b = READ_BIT1(in, j);
-		WRITE_BIT1(temp2, i, b);
-	}
+	return createCRC6(in, length) == readBits(in, length, 6U);
+}
 
-	return temp1[0U] == temp2[0U] && temp1[1U] == temp2[1U];
+void CNXDNCRC::encodeCRC6(unsigned char* in, unsigned int length)
+{
+	assert(in != NULL);
+
+	writeBits(in, length, 6U, createCRC6(in, length));
 }
 
-void CNXDNCRC::encodeCRC12(unsigned char* in, unsigned int length)
+bool CNXDNCRC::checkCRC12(const unsigned char* in, unsigned int length)
 {
 	assert(in != NULL);
 
-	uint16_t crc = createCRC12(in, length);
+	return createCRC12(in, length) == readBits(in, length, 12U);
+}
 
-	uint8_t temp[2U];
-	temp[0U] = (crc >> 8) & 0xFFU;
-	temp[1U] = (crc >> 0) & 0xFFU;
+void CNXDNCRC::encodeCRC12(unsigned char* in, unsigned int length)
+{
+	assert(in != NULL);
 
-	unsigned int n = length;
-	for (unsigned int i = 4U; i < 16U; i++, n++) {
-		bool b = READ_BIT1(temp, i);
-		WRITE_BIT1(in, n, b);
-	}
+	writeBits(in, length, 12U, createCRC12(in, length));
 }
 
 bool CNXDNCRC::checkCRC15(const unsigned char* in, unsigned int length)
 {
 	assert(in != NULL);
 
-	uint16_t crc = createCRC15(in, length);
-	uint8_t temp1[2U];
-	temp1[0U] = (crc >> 8) & 0xFFU;
-	temp1[1U] = (crc >> 0) & 0xFFU;
-
-	uint8_t temp2[2U];
-	temp2[0U] = 0x00U;
-	temp2[1U] = 0x00U;
-	unsigned int j = length;
-	for (unsigned int i = 1U; i < 16U; i++, j++) {
-		bool b = READ_BIT1(in, j);
-		WRITE_BIT1(temp2, i, b);
-	}
-
-	return temp1[0U] == temp2[0U] && temp1[1U] == temp2[1U];
+	return createCRC15(in, length) == readBits(in, length, 15U);
 }
 
 void CNXDNCRC::encodeCRC15(unsigned char* in, unsigned int length)
 {
 	assert(in != NULL);
 
-	uint16_t crc = createCRC15(in, length);
-
-	uint8_t temp[2U];
-	temp[0U] = (crc >> 8) & 0xFFU;
-	temp[1U] = (crc >> 0) & 0xFFU;
-
-	unsigned int n = length;
-	for (unsigned int i = 1U; i < 16U; i++, n++) {
-		bool b = READ_BIT1(temp, i);
-		WRITE_BIT1(in, n, b);
-	}
+	writeBits(in, length, 15U, createCRC15(in, length));
 }
 
 uint8_t CNXDNCRC::createCRC6(const unsigned char* in, unsigned int length)
 {
-	uint8_t crc = 0x3FU;
-
-	for (unsigned int i = 0U; i < length; i++) {
-		bool bit1 = READ_BIT1(in, i) != 0x00U;
-		bool bit2 = (crc & 0x20U) == 0x20U;
-
-		crc <<= 1;
-
-		if (bit1 ^ bit2)
-			crc ^= 0x27U;
-	}
-
-	return crc & 0x3FU;
+	return ::createCRC(CRC6_TABLE, CRC6_POLY << 10, 0x3FU << 10, in, length) >> 10;
 }
 
 uint16_t CNXDNCRC::createCRC12(const unsigned char* in, unsigned int length)
 {
-	uint16_t crc = 0x0FFFU;
-
-	for (unsigned int i = 0U; i < length; i++) {
-		bool bit1 = READ_BIT1(in, i) != 0x00U;
-		bool bit2 = (crc & 0x0800U) == 0x0800U;
-
-		crc <<= 1;
-
-		if (bit1 ^ bit2)
-			crc ^= 0x080FU;
-	}
-
-	return crc & 0x0FFFU;
+	return ::createCRC(CRC12_TABLE, CRC12_POLY << 4, 0x0FFFU << 4, in, length) >> 4;
 }
 
 uint16_t CNXDNCRC::createCRC15(const unsigned char* in, unsigned int length)
 {
-	uint16_t crc = 0x7FFFU;
-
-	for (unsigned int i = 0U; i < length; i++) {
-		bool bit1 = READ_BIT1(in, i) != 0x00U;
-		bool bit2 = (crc & 0x4000U) == 0x4000U;
-
-		crc <<= 1;
-
-		if (bit1 ^ bit2)
-			crc ^= 0x4CC5U;
-	}
-
-	return crc & 0x7FFFU;
+	return ::createCRC(CRC15_TABLE, CRC15_POLY << 1, 0x7FFFU << 1, in, length) >> 1;
 }
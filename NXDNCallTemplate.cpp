@@ -0,0 +1,151 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "NXDNCallTemplate.h"
+#include "NXDNDefines.h"
+#include "NXDNLayer3.h"
+#include "NXDNSACCH.h"
+#include "NXDNLICH.h"
+
+#include <cstdio>
+#include <cassert>
+#include <cstring>
+
+// The LICH byte and the four SACCH bytes
+const unsigned int VOICE_PREFIX_LENGTH = 5U;
+
+const unsigned int NXDN_FRAME_LENGTH = 33U;
+
+const unsigned char SACCH_STRUCTURES[] = {NXDN_SR_1_4, NXDN_SR_2_4, NXDN_SR_3_4, NXDN_SR_4_4};
+
+CNXDNCallTemplate::CNXDNCallTemplate() :
+m_valid(false),
+m_srcId(0U),
+m_dstId(0U),
+m_ran(0U),
+m_header(NULL),
+m_release(NULL),
+m_voice(NULL)
+{
+	m_header  = new unsigned char[NXDN_FRAME_LENGTH];
+	m_release = new unsigned char[NXDN_FRAME_LENGTH];
+	m_voice   = new unsigned char[4U * VOICE_PREFIX_LENGTH];
+}
+
+CNXDNCallTemplate::~CNXDNCallTemplate()
+{
+	delete[] m_header;
+	delete[] m_release;
+	delete[] m_voice;
+}
+
+void CNXDNCallTemplate::setCall(unsigned short srcId, unsigned short dstId, unsigned char ran)
+{
+	if (m_valid && srcId == m_srcId && dstId == m_dstId && ran == m_ran)
+		return;
+
+	m_srcId = srcId;
+	m_dstId = dstId;
+	m_ran   = ran;
+
+	encodeFrame(m_header, NXDN_MESSAGE_TYPE_VCALL);
+	encodeFrame(m_release, NXDN_MESSAGE_TYPE_TX_REL);
+
+	CNXDNLICH lich;
+	lich.setRFCT(NXDN_LICH_RFCT_RDCH);
+	lich.setFCT(NXDN_LICH_USC_SACCH_SS);
+	lich.setOption(NXDN_LICH_STEAL_NONE);
+	lich.setDirection(NXDN_LICH_DIRECTION_INBOUND);
+
+	CNXDNLayer3 layer3;
+	layer3.setMessageType(NXDN_MESSAGE_TYPE_VCALL);
+	layer3.setSourceUnitId(m_srcId);
+	layer3.setDestinationGroupId(m_dstId);
+	layer3.setGroup(true);
+	layer3.setDataBlocks(0U);
+
+	for (unsigned int i = 0U; i < 4U; i++) {
+		unsigned char* prefix = m_voice + i * VOICE_PREFIX_LENGTH;
+
+		prefix[0U] = lich.getRaw();
+
+		unsigned char message[3U];
+		layer3.encode(message, 18U, i * 18U);
+
+		CNXDNSACCH sacch;
+		sacch.setStructure(SACCH_STRUCTURES[i]);
+		sacch.setData(message);
+		sacch.setRAN(m_ran);
+		sacch.getRaw(prefix + 1U);
+	}
+
+	m_valid = true;
+}
+
+void CNXDNCallTemplate::getHeader(unsigned char* data) const
+{
+	assert(data != NULL);
+	assert(m_valid);
+
+	::memcpy(data, m_header, NXDN_FRAME_LENGTH);
+}
+
+void CNXDNCallTemplate::getRelease(unsigned char* data) const
+{
+	assert(data != NULL);
+	assert(m_valid);
+
+	::memcpy(data, m_release, NXDN_FRAME_LENGTH);
+}
+
+void CNXDNCallTemplate::getVoice(unsigned char* data, unsigned int seqNo) const
+{
+	assert(data != NULL);
+	assert(m_valid);
+
+	::memcpy(data, m_voice + (seqNo % 4U) * VOICE_PREFIX_LENGTH, VOICE_PREFIX_LENGTH);
+}
+
+void CNXDNCallTemplate::encodeFrame(unsigned char* data, unsigned char messageType) const
+{
+	CNXDNLICH lich;
+	lich.setRFCT(NXDN_LICH_RFCT_RDCH);
+	lich.setFCT(NXDN_LICH_USC_SACCH_NS);
+	lich.setOption(NXDN_LICH_STEAL_FACCH);
+	lich.setDirection(NXDN_LICH_DIRECTION_INBOUND);
+	data[0U] = lich.getRaw();
+
+	CNXDNSACCH sacch;
+	sacch.setRAN(m_ran);
+	sacch.setStructure(NXDN_SR_SINGLE);
+	sacch.setData(SACCH_IDLE);
+	sacch.getRaw(data + 1U);
+
+	unsigned char layer3data[25U];
+	CNXDNLayer3 layer3;
+	layer3.setMessageType(messageType);
+	layer3.setSourceUnitId(m_srcId);
+	layer3.setDestinationGroupId(m_dstId);
+	layer3.setGroup(true);
+	layer3.setDataBlocks(0U);
+	layer3.getData(layer3data);
+
+	// The FACCH1 is sent twice
+	::memcpy(data + 5U, layer3data, 14U);
+	::memcpy(data + 5U + 14U, layer3data, 14U);
+}
@@ -0,0 +1,52 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(NXDNCALLTEMPLATE_H)
+#define	NXDNCALLTEMPLATE_H
+
+// The parts of the outgoing NXDN frames that only depend on the call. The
+// VCALL header and TX_REL frames are built whole, and the LICH and SACCH of
+// the voice frames for each of the four SACCH superframe positions, so a
+// voice frame only needs its first five bytes replaced.
+class CNXDNCallTemplate {
+public:
+	CNXDNCallTemplate();
+	~CNXDNCallTemplate();
+
+	// The frames are only encoded again when one of the values has changed
+	void setCall(unsigned short srcId, unsigned short dstId, unsigned char ran);
+
+	void getHeader(unsigned char* data) const;
+	void getRelease(unsigned char* data) const;
+
+	// The LICH and the SACCH fragment for the frame sequence number
+	void getVoice(unsigned char* data, unsigned int seqNo) const;
+
+private:
+	bool           m_valid;
+	unsigned short m_srcId;
+	unsigned short m_dstId;
+	unsigned char  m_ran;
+	unsigned char* m_header;
+	unsigned char* m_release;
+	unsigned char* m_voice;
+
+	void encodeFrame(unsigned char* data, unsigned char messageType) const;
+};
+
+#endif
@@ -17,12 +17,30 @@
  */
 
 #include "NXDNConvolution.h"
+#include "CPUFeatures.h"
 
 #include <cstdio>
 #include <cassert>
 #include <cstring>
 #include <cstdlib>
 
+// The 16 state metrics fit two 128 bit registers, so the eight butterflies
+// of a step run side by side where the CPU has SSE2 or NEON. A 32 bit ARM
+// target without NEON builds the NEON kernel with a target attribute.
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define	CONVOLUTION_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(CPU_DISPATCH_ARM)
+#include <arm_neon.h>
+#define	CONVOLUTION_NEON
+#endif
+
+#if defined(CPU_DISPATCH_ARM)
+#define	NEON_TARGET	CPU_TARGET("fpu=neon")
+#else
+#define	NEON_TARGET
+#endif
+
 const unsigned char BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
 
 #define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
@@ -36,6 +54,124 @@ const unsigned int NUM_OF_STATES = 16U;
 const uint32_t     M = 4U;
 const unsigned int K = 5U;
 
+// One add-compare-select step over the 16 states, returning the decision bits
+typedef uint64_t (*ACSKernel)(const uint16_t* oldMetrics, uint16_t* newMetrics, uint8_t s0, uint8_t s1);
+
+static uint64_t acsScalar(const uint16_t* oldMetrics, uint16_t* newMetrics, uint8_t s0, uint8_t s1)
+{
+  uint64_t decisions = 0U;
+
+  for (uint8_t i = 0U; i < NUM_OF_STATES_D2; i++) {
+    uint8_t j = i * 2U;
+
+    uint16_t metric = std::abs(BRANCH_TABLE1[i] - s0) + std::abs(BRANCH_TABLE2[i] - s1);
+
+    uint16_t m0 = oldMetrics[i] + metric;
+    uint16_t m1 = oldMetrics[i + NUM_OF_STATES_D2] + (M - metric);
+    uint8_t decision0 = (m0 >= m1) ? 1U : 0U;
+    newMetrics[j + 0U] = decision0 != 0U ? m1 : m0;
+
+    m0 = oldMetrics[i] + (M - metric);
+    m1 = oldMetrics[i + NUM_OF_STATES_D2] + metric;
+    uint8_t decision1 = (m0 >= m1) ? 1U : 0U;
+    newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
+
+    decisions |= (uint64_t(decision1) << (j + 1U)) | (uint64_t(decision0) << (j + 0U));
+  }
+
+  return decisions;
+}
+
+#if defined(CONVOLUTION_SSE2)
+static uint64_t acsSSE2(const uint16_t* oldMetrics, uint16_t* newMetrics, uint8_t s0, uint8_t s1)
+{
+  const __m128i branch1 = _mm_setr_epi16(0, 0, 0, 0, 2, 2, 2, 2);
+  const __m128i branch2 = _mm_setr_epi16(0, 2, 2, 0, 0, 2, 2, 0);
+
+  __m128i v0 = _mm_set1_epi16(s0);
+  __m128i v1 = _mm_set1_epi16(s1);
+
+  // |BRANCH_TABLE1[i] - s0| + |BRANCH_TABLE2[i] - s1| for the eight butterflies
+  __m128i metric = _mm_add_epi16(_mm_max_epi16(_mm_sub_epi16(branch1, v0), _mm_sub_epi16(v0, branch1)),
+                                 _mm_max_epi16(_mm_sub_epi16(branch2, v1), _mm_sub_epi16(v1, branch2)));
+  __m128i inverse = _mm_sub_epi16(_mm_set1_epi16(M), metric);
+
+  __m128i lo = _mm_loadu_si128((const __m128i*)(oldMetrics + 0U));
+  __m128i hi = _mm_loadu_si128((const __m128i*)(oldMetrics + NUM_OF_STATES_D2));
+
+  // The metrics never exceed 4 x 300, so signed compares are safe
+  __m128i m0 = _mm_add_epi16(lo, metric);
+  __m128i m1 = _mm_add_epi16(hi, inverse);
+  __m128i less0 = _mm_cmpgt_epi16(m1, m0);
+  __m128i new0  = _mm_min_epi16(m0, m1);
+
+  m0 = _mm_add_epi16(lo, inverse);
+  m1 = _mm_add_epi16(hi, metric);
+  __m128i less1 = _mm_cmpgt_epi16(m1, m0);
+  __m128i new1  = _mm_min_epi16(m0, m1);
+
+  _mm_storeu_si128((__m128i*)(newMetrics + 0U),                _mm_unpacklo_epi16(new0, new1));
+  _mm_storeu_si128((__m128i*)(newMetrics + NUM_OF_STATES_D2), _mm_unpackhi_epi16(new0, new1));
+
+  // A decision is set where m0 >= m1, the inverse of the compare masks
+  __m128i less = _mm_packs_epi16(_mm_unpacklo_epi16(less0, less1), _mm_unpackhi_epi16(less0, less1));
+  return uint64_t(~_mm_movemask_epi8(less) & 0xFFFF);
+}
+#endif
+
+#if defined(CONVOLUTION_NEON)
+NEON_TARGET static uint64_t acsNEON(const uint16_t* oldMetrics, uint16_t* newMetrics, uint8_t s0, uint8_t s1)
+{
+  static const uint16_t BRANCH1[] = {0U, 0U, 0U, 0U, 2U, 2U, 2U, 2U};
+  static const uint16_t BRANCH2[] = {0U, 2U, 2U, 0U, 0U, 2U, 2U, 0U};
+  static const uint16_t WEIGHTS[] = {0x01U, 0x02U, 0x04U, 0x08U, 0x10U, 0x20U, 0x40U, 0x80U};
+
+  // |BRANCH_TABLE1[i] - s0| + |BRANCH_TABLE2[i] - s1| for the eight butterflies
+  uint16x8_t metric  = vaddq_u16(vabdq_u16(vld1q_u16(BRANCH1), vdupq_n_u16(s0)), vabdq_u16(vld1q_u16(BRANCH2), vdupq_n_u16(s1)));
+  uint16x8_t inverse = vsubq_u16(vdupq_n_u16(M), metric);
+
+  uint16x8_t lo = vld1q_u16(oldMetrics + 0U);
+  uint16x8_t hi = vld1q_u16(oldMetrics + NUM_OF_STATES_D2);
+
+  uint16x8_t m0 = vaddq_u16(lo, metric);
+  uint16x8_t m1 = vaddq_u16(hi, inverse);
+  uint16x8_t decision0 = vcgeq_u16(m0, m1);
+  uint16x8_t new0      = vminq_u16(m0, m1);
+
+  m0 = vaddq_u16(lo, inverse);
+  m1 = vaddq_u16(hi, metric);
+  uint16x8_t decision1 = vcgeq_u16(m0, m1);
+  uint16x8_t new1      = vminq_u16(m0, m1);
+
+  uint16x8x2_t metrics = vzipq_u16(new0, new1);
+  vst1q_u16(newMetrics + 0U,                metrics.val[0U]);
+  vst1q_u16(newMetrics + NUM_OF_STATES_D2, metrics.val[1U]);
+
+  // Weight each decision mask by its bit in the byte and add them up
+  uint16x8x2_t decisions = vzipq_u16(decision0, decision1);
+  uint16x8_t weights = vld1q_u16(WEIGHTS);
+  uint64x2_t sum0 = vpaddlq_u32(vpaddlq_u16(vandq_u16(decisions.val[0U], weights)));
+  uint64x2_t sum1 = vpaddlq_u32(vpaddlq_u16(vandq_u16(decisions.val[1U], weights)));
+  return (vgetq_lane_u64(sum0, 0) + vgetq_lane_u64(sum0, 1)) | ((vgetq_lane_u64(sum1, 0) + vgetq_lane_u64(sum1, 1)) << 8);
+}
+#endif
+
+// The vector kernels are only taken where the CPU reports the extension, the scalar one otherwise
+static ACSKernel selectKernel()
+{
+#if defined(CONVOLUTION_SSE2)
+  if (CCPUFeatures::hasSSE2())
+    return acsSSE2;
+#endif
+#if defined(CONVOLUTION_NEON)
+  if (CCPUFeatures::hasNEON())
+    return acsNEON;
+#endif
+  return acsScalar;
+}
+
+static const ACSKernel ACS_KERNEL = selectKernel();
+
 CNXDNConvolution::CNXDNConvolution() :
 m_metrics1(NULL),
 m_metrics2(NULL),
@@ -56,6 +192,19 @@ CNXDNConvolution::~CNXDNConvolution()
 	delete[] m_decisions;
 }
 
+const char* CNXDNConvolution::getKernel()
+{
+#if defined(CONVOLUTION_SSE2)
+	if (ACS_KERNEL == acsSSE2)
+		return "SSE2";
+#endif
+#if defined(CONVOLUTION_NEON)
+	if (ACS_KERNEL == acsNEON)
+		return "NEON";
+#endif
+	return "scalar";
+}
+
 void CNXDNConvolution::start()
 {
 	::memset(m_metrics1, 0x00U, NUM_OF_STATES * sizeof(uint16_t));
@@ -68,25 +217,7 @@ void CNXDNConvolution::start()
 
 void CNXDNConvolution::decode(uint8_t s0, uint8_t s1)
 {
-  *m_dp = 0U;
-
-  for (uint8_t i = 0U; i < NUM_OF_STATES_D2; i++) {
-    uint8_t j = i * 2U;
-
-    uint16_t metric = std::abs(BRANCH_TABLE1[i] - s0) + std::abs(BRANCH_TABLE2[i] - s1);
-
-    uint16_t m0 = m_oldMetrics[i] + metric;
-    uint16_t m1 = m_oldMetrics[i + NUM_OF_STATES_D2] + (M - metric);
-    uint8_t decision0 = (m0 >= m1) ? 1U : 0U;
-    m_newMetrics[j + 0U] = decision0 != 0U ? m1 : m0;
-
-    m0 = m_oldMetrics[i] + (M - metric);
-    m1 = m_oldMetrics[i + NUM_OF_STATES_D2] + metric;
-    uint8_t decision1 = (m0 >= m1) ? 1U : 0U;
-    m_newMetrics[j + 1U] = decision1 != 0U ? m1 : m0;
-
-    *m_dp |= (uint64_t(decision1) << (j + 1U)) | (uint64_t(decision0) << (j + 0U));
-  }
+  *m_dp = ACS_KERNEL(m_oldMetrics, m_newMetrics, s0, s1);
 
   ++m_dp;
 
@@ -32,6 +32,8 @@ public:
 
 	void encode(const unsigned char* in, unsigned char* out, unsigned int nBits) const;
 
+	static const char* getKernel();
+
 private:
 	uint16_t* m_metrics1;
 	uint16_t* m_metrics2;
@@ -18,15 +18,46 @@
 
 #include "NXDNDefines.h"
 #include "NXDNLICH.h"
+#include "BitPermutation.h"
+#include "FECTables.h"
 
 #include <cstdio>
 #include <cassert>
 #include <cstring>
 
-const unsigned char BIT_MASK_TABLE[] = {0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U};
+// The LICH is sent as every other bit after the FSW, starting at bit 4 of byte 2
+static constexpr CLookupTable<unsigned int, NXDN_LICH_LENGTH_BITS / 2U> makeDecodeTable()
+{
+	CLookupTable<unsigned int, NXDN_LICH_LENGTH_BITS / 2U> table = {};
+
+	for (unsigned int i = 0U; i < NXDN_LICH_LENGTH_BITS / 2U; i++)
+		table.m_value[i] = i * 2U;
+
+	return table;
+}
 
-#define WRITE_BIT1(p,i,b) p[(i)>>3] = (b) ? (p[(i)>>3] | BIT_MASK_TABLE[(i)&7]) : (p[(i)>>3] & ~BIT_MASK_TABLE[(i)&7])
-#define READ_BIT1(p,i)    (p[(i)>>3] & BIT_MASK_TABLE[(i)&7])
+// The even bits sent carry the LICH, the odd ones are filled in
+static constexpr CLookupTable<unsigned int, NXDN_LICH_LENGTH_BITS> makeEncodeTable()
+{
+	CLookupTable<unsigned int, NXDN_LICH_LENGTH_BITS> table = {};
+
+	for (unsigned int i = 0U; i < NXDN_LICH_LENGTH_BITS; i++)
+		table.m_value[i] = (i % 2U) == 0U ? i / 2U : BIT_PERMUTATION_NONE;
+
+	return table;
+}
+
+static constexpr CLookupTable<unsigned int, NXDN_LICH_LENGTH_BITS / 2U> LICH_DECODE_TABLE = makeDecodeTable();
+static constexpr CLookupTable<unsigned int, NXDN_LICH_LENGTH_BITS>      LICH_ENCODE_TABLE = makeEncodeTable();
+
+static_assert(CFECTables::hash(LICH_DECODE_TABLE) == 0x2947CC95U, "LICH decode table mismatch");
+static_assert(CFECTables::hash(LICH_ENCODE_TABLE) == 0x451DCAB5U, "LICH encode table mismatch");
+
+constexpr CBitPermutation<3U> LICH_DECODE(LICH_DECODE_TABLE.m_value, NXDN_LICH_LENGTH_BITS / 2U, NXDN_FSW_LENGTH_BITS - 16U);
+constexpr CBitPermutation<1U> LICH_ENCODE(LICH_ENCODE_TABLE.m_value, NXDN_LICH_LENGTH_BITS);
+
+// The odd bits of the transmitted LICH are always set
+const uint64_t LICH_ENCODE_FILL = 0x5555000000000000ULL;
 
 CNXDNLICH::CNXDNLICH(const CNXDNLICH& lich) :
 m_lich(NULL)
@@ -50,11 +81,7 @@ bool CNXDNLICH::decode(const unsigned char* bytes)
 {
 	assert(bytes != NULL);
 
-	unsigned int offset = NXDN_FSW_LENGTH_BITS;
-	for (unsigned int i = 0U; i < (NXDN_LICH_LENGTH_BITS / 2U); i++, offset += 2U) {
-		bool b = READ_BIT1(bytes, offset);
-		WRITE_BIT1(m_lich, i, b);
-	}
+	m_lich[0U] = LICH_DECODE.permute(bytes + 2U) >> 56;
 
 	bool newParity  = getParity();
 	bool origParity = (m_lich[0U] & 0x01U) == 0x01U;
@@ -72,14 +99,9 @@ void CNXDNLICH::encode(unsigned char* bytes)
 	else
 		m_lich[0U] &= 0xFEU;
 
-	unsigned int offset = NXDN_FSW_LENGTH_BITS;
-	for (unsigned int i = 0U; i < (NXDN_LICH_LENGTH_BITS / 2U); i++) {
-		bool b = READ_BIT1(m_lich, i);
-		WRITE_BIT1(bytes, offset, b);
-		offset++;
-		WRITE_BIT1(bytes, offset, true);
-		offset++;
-	}
+	uint64_t lich = LICH_ENCODE.permute(m_lich) | LICH_ENCODE_FILL;
+
+	CBitPermutation<1U>::put(bytes, NXDN_FSW_LENGTH_BITS, NXDN_LICH_LENGTH_BITS, lich);
 }
 
 unsigned char CNXDNLICH::getRFCT() const
@@ -20,18 +20,18 @@
 #include "Timer.h"
 #include "Log.h"
 
+#include <cassert>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <cctype>
 
-CNXDNLookup::CNXDNLookup(const std::string& filename, unsigned int reloadTime) :
+CNXDNLookup::CNXDNLookup(const std::string& filename, const std::string& index, unsigned int reloadTime) :
 CThread(),
 m_filename(filename),
+m_index(index),
 m_reloadTime(reloadTime),
-m_table(),
-m_cstable(),
-m_mutex(),
+m_table(new CIdTable),
 m_stop(false)
 {
 }
@@ -82,69 +82,88 @@ void CNXDNLookup::stop()
 	wait();
 }
 
-std::string CNXDNLookup::findCS(unsigned int id)
+const char* CNXDNLookup::findCS(unsigned int id, char* callsign)
 {
-	std::string callsign;
+	assert(callsign != NULL);
 
-	if (id == 0xFFFFU)
-		return std::string("ALL");
+	if (id == 0xFFFFU) {
+		::strcpy(callsign, "ALL");
+		return callsign;
+	}
 
-	m_mutex.lock();
+	unsigned int epoch;
+	const CIdTable* table = m_table.acquire(epoch);
 
-	try {
-		callsign = m_table.at(id);
-	} catch (...) {
-		char text[10U];
-		::sprintf(text, "%u", id);
-		callsign = std::string(text);
-	}
+	const char* found = table->findCS(id);
+	if (found != NULL)
+		::memcpy(callsign, found, ID_CALLSIGN_LENGTH);
+
+	m_table.release(epoch);
 
-	m_mutex.unlock();
+	if (found == NULL)
+		CIdTable::toDecimal(id, callsign);
 
 	return callsign;
 }
 
-unsigned int CNXDNLookup::findID(std::string cs)
+unsigned int CNXDNLookup::findID(const char* callsign)
 {
-	unsigned int nxdnID;
+	assert(callsign != NULL);
 
-	m_mutex.lock();
+	unsigned int epoch;
+	const CIdTable* table = m_table.acquire(epoch);
 
-	try {
-		nxdnID = m_cstable.at(cs);
-	} catch (...) {
-		nxdnID = 0U;
-	}
+	unsigned int nxdnID = table->findID(callsign);
 
-	m_mutex.unlock();
+	m_table.release(epoch);
 
 	return nxdnID;
 }
 
 bool CNXDNLookup::exists(unsigned int id)
 {
-	m_mutex.lock();
+	unsigned int epoch;
+	const CIdTable* table = m_table.acquire(epoch);
 
-	bool found = m_table.count(id) == 1U;
+	bool found = table->exists(id);
 
-	m_mutex.unlock();
+	m_table.release(epoch);
 
 	return found;
 }
 
 bool CNXDNLookup::load()
 {
+	// Mapping an index compiled earlier, perhaps by another process, avoids parsing the lookup file
+	if (!m_index.empty()) {
+		CIdTable* table = new CIdTable;
+		if (table->map(m_index, m_filename)) {
+			unsigned int size = table->size();
+
+			m_table.publish(table);
+
+			LogInfo("Mapped %u Ids from the NXDN Id index - %s", size, m_index.c_str());
+
+			return size > 0U;
+		}
+
+		delete table;
+	}
+
+	// Taken before the file is opened, a change while it is parsed then shows up as a different size or time
+	uint64_t sourceSize;
+	int64_t  sourceTime;
+	bool sourceExists = CIdTable::getSource(m_filename, sourceSize, sourceTime);
+
 	FILE* fp = ::fopen(m_filename.c_str(), "rt");
 	if (fp == NULL) {
 		LogWarning("Cannot open the NXDN Id lookup file - %s", m_filename.c_str());
 		return false;
 	}
 
-	m_mutex.lock();
-
-	// Remove the old entries
-	m_table.clear();
-	m_cstable.clear();
+	// The new entries are loaded off to the side, the lookups keep using the old ones until they are published
+	CIdTable* table = new CIdTable;
+	unsigned int rejected = 0U;
 
 	char buffer[100U];
 	while (::fgets(buffer, 100U, fp) != NULL) {
@@ -160,21 +179,49 @@ bool CNXDNLookup::load()
 				for (char* p = p2; *p != 0x00U; p++)
 					*p = ::toupper(*p);
 
-				m_table[id] = std::string(p2);
-				m_cstable[p2] = id;
+				if (!table->add(id, p2))
+					rejected++;
 			}
 		}
 	}
 
-	m_mutex.unlock();
-
 	::fclose(fp);
 
-	size_t size = m_table.size();
+	if (rejected > 0U)
+		LogWarning("Skipped %u NXDN Ids with callsigns longer than %u characters", rejected, ID_CALLSIGN_LENGTH - 1U);
+
+	table->sort();
+
+	// The parsed copy is only used when the index cannot be written and mapped back. A file
+	// changed while it was parsed may be half written, it is parsed again at the next load.
+	if (!m_index.empty()) {
+		uint64_t size;
+		int64_t  time;
+		bool unchanged = sourceExists && CIdTable::getSource(m_filename, size, time) && size == sourceSize && time == sourceTime;
+
+		if (unchanged) {
+			CIdTable* mapped = new CIdTable;
+			if (table->save(m_index, sourceSize, sourceTime) && mapped->map(m_index, m_filename)) {
+				delete table;
+				table = mapped;
+			} else {
+				LogWarning("Cannot compile the NXDN Id index - %s", m_index.c_str());
+				delete mapped;
+			}
+		} else {
+			LogWarning("The NXDN Id lookup file changed while it was read, not compiling the index - %s", m_filename.c_str());
+		}
+	}
+
+	unsigned int size   = table->size();
+	unsigned int memory = table->memory();
+
+	m_table.publish(table);
+
 	if (size == 0U)
 		return false;
 
-	LogInfo("Loaded %u Ids to the NXDN callsign lookup table", size);
+	LogInfo("Loaded %u Ids to the NXDN callsign lookup table, %u bytes per Id", size, memory / size);
 
 	return true;
 }
\ No newline at end of file
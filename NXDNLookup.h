@@ -19,23 +19,24 @@
 #ifndef	NXDNLookup_H
 #define	NXDNLookup_H
 
+#include "Snapshot.h"
+#include "IdTable.h"
 #include "Thread.h"
-#include "Mutex.h"
 
 #include <string>
-#include <unordered_map>
 
 class CNXDNLookup : public CThread {
 public:
-	CNXDNLookup(const std::string& filename, unsigned int reloadTime);
+	CNXDNLookup(const std::string& filename, const std::string& index, unsigned int reloadTime);
 	virtual ~CNXDNLookup();
 
 	bool read();
 
 	virtual void entry();
 
-	std::string findCS(unsigned int id);
-	unsigned int findID(std::string cs);
+	// Copies the callsign, or the Id in decimal when it is unknown, to a buffer of ID_CALLSIGN_LENGTH
+	const char* findCS(unsigned int id, char* callsign);
+	unsigned int findID(const char* callsign);
 
 	bool exists(unsigned int id);
 
@@ -43,10 +44,9 @@ public:
 
 private:
 	std::string                                   m_filename;
+	std::string                                   m_index;
 	unsigned int                                  m_reloadTime;
-	std::unordered_map<unsigned int, std::string> m_table;
-	std::unordered_map<std::string, unsigned int> m_cstable;
-	CMutex                                        m_mutex;
+	CSnapshot<CIdTable>                           m_table;
 	bool                                          m_stop;
 
 	bool load();
@@ -25,20 +25,29 @@
 #include <cassert>
 #include <cstring>
 
-const unsigned int BUFFER_LENGTH = 200U;
-
 CNXDNNetwork::CNXDNNetwork(const std::string& address, unsigned int port, const std::string& callsign, bool debug) :
 m_socket(address, port),
 m_callsign(callsign),
 m_debug(debug),
 m_address(),
-m_port(0U)
+m_port(0U),
+m_batch(NULL),
+m_batchCount(0U),
+m_batchPtr(0U)
 {
 	m_callsign.resize(10U, ' ');
+
+	m_batch = new CUDPDatagram[UDP_BATCH_SIZE];
 }
 
 CNXDNNetwork::~CNXDNNetwork()
 {
+	delete[] m_batch;
+}
+
+void CNXDNNetwork::setReactor(CReactor* reactor)
+{
+	m_socket.setReactor(reactor);
 }
 
 bool CNXDNNetwork::open()
@@ -71,6 +80,26 @@ bool CNXDNNetwork::write(const unsigned char* data, unsigned int length)
 	return m_socket.write(data, length, m_address, m_port);
 }
 
+bool CNXDNNetwork::write(const unsigned char* data, unsigned int length, unsigned int count)
+{
+	assert(data != NULL);
+	assert(length > 0U && length <= UDP_DATAGRAM_LENGTH);
+	assert(count > 0U && count <= UDP_BATCH_SIZE);
+
+	if (count == 1U)
+		return m_socket.write(data, length, m_address, m_port);
+
+	CUDPDatagram datagrams[UDP_BATCH_SIZE];
+	for (unsigned int i = 0U; i < count; i++) {
+		::memcpy(datagrams[i].m_data, data, length);
+		datagrams[i].m_length  = length;
+		datagrams[i].m_address = m_address;
+		datagrams[i].m_port    = m_port;
+	}
+
+	return m_socket.write(datagrams, count);
+}
+
 bool CNXDNNetwork::write(const unsigned char* data, unsigned short srcId, unsigned short dstId, bool grp)
 {
 	assert(data != NULL);
@@ -105,31 +134,41 @@ bool CNXDNNetwork::write(const unsigned char* data, unsigned short srcId, unsign
 	return m_socket.write(buffer, 43U, m_address, m_port);
 }
 
+// Returns the datagrams of one recvmmsg() batch before reading the socket again
 unsigned int CNXDNNetwork::read(unsigned char* data)
 {
 	assert(data != NULL);
 
-	in_addr address;
-	unsigned int port;
+	for (;;) {
+		if (m_batchPtr == m_batchCount) {
+			int n = m_socket.read(m_batch, UDP_BATCH_SIZE);
+			if (n <= 0)
+				return 0U;
 
-	int len = m_socket.read(data, BUFFER_LENGTH, address, port);
-	if (len <= 0)
-		return 0U;
+			m_batchCount = n;
+			m_batchPtr   = 0U;
+		}
 
-	// Invalid packet type?
-	if (::memcmp(data, "NXDN", 4U) != 0)
-		return 0U;
+		const CUDPDatagram& datagram = m_batch[m_batchPtr++];
+		unsigned int len = datagram.m_length;
 
-	if (len != 17 && len != 43)
-		return 0U;
+		// Invalid packet type?
+		if (len < 4U || ::memcmp(datagram.m_data, "NXDN", 4U) != 0)
+			continue;
 
-	if (m_debug)
-		CUtils::dump(1U, "NXDN Network Data Received", data, len);
+		if (len != 17U && len != 43U)
+			continue;
 
-	return len;
+		::memcpy(data, datagram.m_data, len);
+
+		if (m_debug)
+			CUtils::dump(1U, "NXDN Network Data Received", data, len);
+
+		return len;
+	}
 }
 
-bool CNXDNNetwork::writePoll(unsigned short tg)
+bool CNXDNNetwork::writePoll(unsigned short tg, unsigned int count)
 {
 	unsigned char data[20U];
 
@@ -148,10 +187,10 @@ bool CNXDNNetwork::writePoll(unsigned short tg)
 	if (m_debug)
 		CUtils::dump(1U, "NXDN Network Poll Sent", data, 17U);
 
-	return m_socket.write(data, 17U, m_address, m_port);
+	return write(data, 17U, count);
 }
 
-bool CNXDNNetwork::writeUnlink(unsigned short tg)
+bool CNXDNNetwork::writeUnlink(unsigned short tg, unsigned int count)
 {
 	unsigned char data[20U];
 
@@ -170,7 +209,7 @@ bool CNXDNNetwork::writeUnlink(unsigned short tg)
 	if (m_debug)
 		CUtils::dump(1U, "NXDN Network Unlink Sent", data, 17U);
 
-	return m_socket.write(data, 17U, m_address, m_port);
+	return write(data, 17U, count);
 }
 
 void CNXDNNetwork::close()
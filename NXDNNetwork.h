@@ -31,6 +31,8 @@ public:
 	CNXDNNetwork(const std::string& address, unsigned int port, const std::string& callsign, bool debug);
 	~CNXDNNetwork();
 
+	void setReactor(CReactor* reactor);
+
 	bool open();
 
 	void setDestination(const in_addr& address, unsigned int port);
@@ -39,8 +41,8 @@ public:
 	bool write(const unsigned char* data, unsigned int length);
 	bool write(const unsigned char* data, unsigned short srcId, unsigned short dstId, bool grp);
 
-	bool writePoll(unsigned short tg);
-	bool writeUnlink(unsigned short tg);
+	bool writePoll(unsigned short tg, unsigned int count = 1U);
+	bool writeUnlink(unsigned short tg, unsigned int count = 1U);
 
 	unsigned int read(unsigned char* data);
 
@@ -52,6 +54,11 @@ private:
 	bool            m_debug;
 	in_addr         m_address;
 	unsigned int    m_port;
+	CUDPDatagram*   m_batch;
+	unsigned int    m_batchCount;
+	unsigned int    m_batchPtr;
+
+	bool write(const unsigned char* data, unsigned int length, unsigned int count);
 };
 
 #endif
@@ -19,22 +19,66 @@
 #include "NXDNSACCH.h"
 
 #include "NXDNConvolution.h"
+#include "BitPermutation.h"
 #include "NXDNDefines.h"
+#include "FECTables.h"
 #include "NXDNCRC.h"
 
 #include <cstdio>
 #include <cassert>
 #include <cstring>
 
-const unsigned int INTERLEAVE_TABLE[] = {
-	0U, 5U, 10U, 15U, 20U, 25U, 30U, 35U, 40U, 45U, 50U, 55U,
-	1U, 6U, 11U, 16U, 21U, 26U, 31U, 36U, 41U, 46U, 51U, 56U,
-	2U, 7U, 12U, 17U, 22U, 27U, 32U, 37U, 42U, 47U, 52U, 57U,
-	3U, 8U, 13U, 18U, 23U, 28U, 33U, 38U, 43U, 48U, 53U, 58U,
-	4U, 9U, 14U, 19U, 24U, 29U, 34U, 39U, 44U, 49U, 54U, 59U
-};
+// Bit i of the punctured code is bit (i % 12) * 5 + i / 12 of the SACCH as
+// sent, the code being written in columns of five and sent in rows of twelve
+static constexpr CLookupTable<unsigned int, NXDN_SACCH_LENGTH_BITS> makeInterleaveTable()
+{
+	CLookupTable<unsigned int, NXDN_SACCH_LENGTH_BITS> table = {};
+
+	for (unsigned int i = 0U; i < NXDN_SACCH_LENGTH_BITS; i++)
+		table.m_value[i] = (i % 12U) * 5U + i / 12U;
+
+	return table;
+}
+
+static constexpr CLookupTable<unsigned int, NXDN_SACCH_LENGTH_BITS> INTERLEAVE_TABLE = makeInterleaveTable();
+
+static_assert(CFECTables::hash(INTERLEAVE_TABLE) == 0x55F10F09U, "SACCH interleave table mismatch");
+
+constexpr unsigned int PUNCTURE_LIST[] = { 5U, 11U, 17U, 23U, 29U, 35U, 41U, 47U, 53U, 59U, 65U, 71U };
+
+static_assert(sizeof(PUNCTURE_LIST) / sizeof(unsigned int) + NXDN_SACCH_LENGTH_BITS == 72U, "SACCH puncturing does not leave 60 of 72 bits");
+
+// The source of each transmitted SACCH bit in the 72 bit convolutional code,
+// PUNCTURE_LIST removed and INTERLEAVE_TABLE applied in one step
+static constexpr CLookupTable<unsigned int, NXDN_SACCH_LENGTH_BITS> makePunctureInterleaveTable()
+{
+	// The code bit behind each bit of the punctured code
+	unsigned int kept[NXDN_SACCH_LENGTH_BITS] = {};
+
+	unsigned int n = 0U;
+	unsigned int index = 0U;
+	for (unsigned int pos = 0U; n < NXDN_SACCH_LENGTH_BITS; pos++) {
+		if (index < sizeof(PUNCTURE_LIST) / sizeof(unsigned int) && pos == PUNCTURE_LIST[index])
+			index++;
+		else
+			kept[n++] = pos;
+	}
+
+	CLookupTable<unsigned int, NXDN_SACCH_LENGTH_BITS> table = {};
+
+	for (unsigned int i = 0U; i < NXDN_SACCH_LENGTH_BITS; i++)
+		table.m_value[INTERLEAVE_TABLE[i]] = kept[i];
 
-const unsigned int PUNCTURE_LIST[] = { 5U, 11U, 17U, 23U, 29U, 35U, 41U, 47U, 53U, 59U, 65U, 71U };
+	return table;
+}
+
+static constexpr CLookupTable<unsigned int, NXDN_SACCH_LENGTH_BITS> PUNCTURE_INTERLEAVE_TABLE = makePunctureInterleaveTable();
+
+static_assert(CFECTables::hash(PUNCTURE_INTERLEAVE_TABLE) == 0xFFCC565DU, "SACCH puncture and interleave table mismatch");
+
+// The SACCH follows the FSW and LICH, starting at bit 4 of byte 4
+constexpr CBitPermutation<8U> DEINTERLEAVE(INTERLEAVE_TABLE.m_value, NXDN_SACCH_LENGTH_BITS, NXDN_FSW_LENGTH_BITS + NXDN_LICH_LENGTH_BITS - 32U);
+constexpr CBitPermutation<9U> PUNCTURE_INTERLEAVE(PUNCTURE_INTERLEAVE_TABLE.m_value, NXDN_SACCH_LENGTH_BITS);
 
 const unsigned char BIT_MASK_TABLE[] = { 0x80U, 0x40U, 0x20U, 0x10U, 0x08U, 0x04U, 0x02U, 0x01U };
 
@@ -63,13 +107,7 @@ bool CNXDNSACCH::decode(const unsigned char* data)
 {
 	assert(data != NULL);
 
-	unsigned char temp1[8U];
-
-	for (unsigned int i = 0U; i < NXDN_SACCH_LENGTH_BITS; i++) {
-		unsigned int n = INTERLEAVE_TABLE[i] + NXDN_FSW_LENGTH_BITS + NXDN_LICH_LENGTH_BITS;
-		bool b = READ_BIT1(data, n);
-		WRITE_BIT1(temp1, i, b);
-	}
+	uint64_t temp1 = DEINTERLEAVE.permute(data + 4U);
 
 	uint8_t temp2[90U];
 
@@ -81,13 +119,12 @@ bool CNXDNSACCH::decode(const unsigned char* data)
 			index++;
 		}
 
-		bool b = READ_BIT1(temp1, i);
+		bool b = ((temp1 >> (63U - i)) & 0x01U) == 0x01U;
 		temp2[n++] = b ? 2U : 0U;
 	}
 
-	for (unsigned int i = 0U; i < 8U; i++) {
+	while (n < 80U)
 		temp2[n++] = 0U;
-	}
 
 	CNXDNConvolution conv;
 	conv.start();
@@ -124,25 +161,9 @@ void CNXDNSACCH::encode(unsigned char* data) const
 	CNXDNConvolution conv;
 	conv.encode(temp1, temp2, 36U);
 
-	unsigned char temp3[8U];
+	uint64_t temp3 = PUNCTURE_INTERLEAVE.permute(temp2);
 
-	unsigned int n = 0U;
-	unsigned int index = 0U;
-	for (unsigned int i = 0U; i < 72U; i++) {
-		if (i != PUNCTURE_LIST[index]) {
-			bool b = READ_BIT1(temp2, i);
-			WRITE_BIT1(temp3, n, b);
-			n++;
-		} else {
-			index++;
-		}
-	}
-
-	for (unsigned int i = 0U; i < NXDN_SACCH_LENGTH_BITS; i++) {
-		unsigned int n = INTERLEAVE_TABLE[i] + NXDN_FSW_LENGTH_BITS + NXDN_LICH_LENGTH_BITS;
-		bool b = READ_BIT1(temp3, i);
-		WRITE_BIT1(data, n, b);
-	}
+	CBitPermutation<9U>::put(data, NXDN_FSW_LENGTH_BITS + NXDN_LICH_LENGTH_BITS, NXDN_SACCH_LENGTH_BITS, temp3);
 }
 
 unsigned char CNXDNSACCH::getRAN() const
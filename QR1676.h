@@ -19,12 +19,23 @@
 #ifndef QR1676_H
 #define QR1676_H
 
+#include "FECTables.h"
+
 class CQR1676 {
 public:
 	static void encode(unsigned char* data);
 
 	static unsigned char decode(const unsigned char* data);
 
+	// The generator polynomial of the (15,7) code
+	static constexpr unsigned int GENERATOR = 0x139U;
+
+	// The (16,7) code word of seven data bits, the (15,7) code word followed by an even parity bit
+	static constexpr unsigned int codeword(unsigned int data)
+	{
+		return CFECTables::extend(CFECTables::codeword(data, 15U, GENERATOR, 8U));
+	}
+
 private:
 	static unsigned int getSyndrome1576(unsigned int pattern);
 };
@@ -0,0 +1,371 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#include "Reactor.h"
+#include "Thread.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <cassert>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <cerrno>
+#elif defined(_WIN32) || defined(_WIN64)
+#include <winsock.h>
+#else
+#include <sys/select.h>
+#include <sys/time.h>
+#include <cerrno>
+#endif
+
+const unsigned int MAX_EVENTS = 16U;
+
+#if !defined(__linux__)
+const unsigned int EVENT_POLL_PER = 5U;
+#endif
+
+CReactor::CReactor() :
+m_fd(-1),
+m_sockets(),
+m_timers(),
+m_events()
+{
+}
+
+CReactor::~CReactor()
+{
+	close();
+}
+
+bool CReactor::open()
+{
+#if defined(__linux__)
+	m_fd = ::epoll_create1(EPOLL_CLOEXEC);
+	if (m_fd < 0) {
+		LogError("Cannot create the epoll instance, err: %d", errno);
+		return false;
+	}
+#endif
+
+	return true;
+}
+
+bool CReactor::addSocket(int fd)
+{
+	assert(fd >= 0);
+
+#if defined(__linux__)
+	epoll_event ev;
+	::memset(&ev, 0x00, sizeof(epoll_event));
+	ev.events  = EPOLLIN;
+	ev.data.fd = fd;
+
+	if (::epoll_ctl(m_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+		LogError("Cannot add the socket to epoll, err: %d", errno);
+		return false;
+	}
+#else
+	m_sockets.push_back(fd);
+#endif
+
+	return true;
+}
+
+void CReactor::removeSocket(int fd)
+{
+#if defined(__linux__)
+	::epoll_ctl(m_fd, EPOLL_CTL_DEL, fd, NULL);
+#else
+	m_sockets.erase(std::remove(m_sockets.begin(), m_sockets.end(), fd), m_sockets.end());
+#endif
+}
+
+int CReactor::addTimer(unsigned int ms)
+{
+	assert(ms > 0U);
+
+	CReactorTimer* timer = new CReactorTimer;
+	timer->m_ms = ms;
+
+#if defined(__linux__)
+	timer->m_fd = ::timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+	if (timer->m_fd < 0) {
+		LogError("Cannot create the timer, err: %d", errno);
+		delete timer;
+		return -1;
+	}
+
+	epoll_event ev;
+	::memset(&ev, 0x00, sizeof(epoll_event));
+	ev.events  = EPOLLIN;
+	ev.data.fd = timer->m_fd;
+
+	if (::epoll_ctl(m_fd, EPOLL_CTL_ADD, timer->m_fd, &ev) < 0) {
+		LogError("Cannot add the timer to epoll, err: %d", errno);
+		::close(timer->m_fd);
+		delete timer;
+		return -1;
+	}
+#endif
+
+	m_timers.push_back(timer);
+
+	return int(m_timers.size()) - 1;
+}
+
+void CReactor::startTimer(int n)
+{
+	assert(n >= 0 && n < int(m_timers.size()));
+
+	CReactorTimer* timer = m_timers.at(n);
+	timer->m_running  = true;
+	timer->m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timer->m_ms);
+
+#if defined(__linux__)
+	itimerspec spec;
+	::memset(&spec, 0x00, sizeof(itimerspec));
+	spec.it_value.tv_sec  = timer->m_ms / 1000U;
+	spec.it_value.tv_nsec = (timer->m_ms % 1000U) * 1000000L;
+
+	::timerfd_settime(timer->m_fd, 0, &spec, NULL);
+#endif
+}
+
+// steady_clock is CLOCK_MONOTONIC on Linux, so its time points can be given to the timerfd directly
+void CReactor::startTimer(int n, const std::chrono::steady_clock::time_point& deadline)
+{
+	assert(n >= 0 && n < int(m_timers.size()));
+
+	CReactorTimer* timer = m_timers.at(n);
+	if (timer->m_running && timer->m_deadline == deadline)
+		return;
+
+	timer->m_running  = true;
+	timer->m_deadline = deadline;
+
+#if defined(__linux__)
+	std::chrono::nanoseconds ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch());
+
+	itimerspec spec;
+	::memset(&spec, 0x00, sizeof(itimerspec));
+	spec.it_value.tv_sec  = time_t(ns.count() / 1000000000LL);
+	spec.it_value.tv_nsec = long(ns.count() % 1000000000LL);
+
+	// A zero value would disarm the timer
+	if (spec.it_value.tv_sec == 0 && spec.it_value.tv_nsec == 0)
+		spec.it_value.tv_nsec = 1L;
+
+	::timerfd_settime(timer->m_fd, TFD_TIMER_ABSTIME, &spec, NULL);
+#endif
+}
+
+void CReactor::stopTimer(int n)
+{
+	assert(n >= 0 && n < int(m_timers.size()));
+
+	CReactorTimer* timer = m_timers.at(n);
+	if (!timer->m_running)
+		return;
+
+	timer->m_running = false;
+
+#if defined(__linux__)
+	itimerspec spec;
+	::memset(&spec, 0x00, sizeof(itimerspec));
+
+	::timerfd_settime(timer->m_fd, 0, &spec, NULL);
+#endif
+}
+
+bool CReactor::isRunning(int n) const
+{
+	assert(n >= 0 && n < int(m_timers.size()));
+
+	return m_timers.at(n)->m_running;
+}
+
+bool CReactor::hasExpired(int n)
+{
+	assert(n >= 0 && n < int(m_timers.size()));
+
+	CReactorTimer* timer = m_timers.at(n);
+	if (!timer->m_running)
+		return false;
+
+#if defined(__linux__)
+	uint64_t expirations = 0U;
+	if (::read(timer->m_fd, &expirations, sizeof(uint64_t)) != ssize_t(sizeof(uint64_t)) || expirations == 0U)
+		return false;
+#else
+	if (std::chrono::steady_clock::now() < timer->m_deadline)
+		return false;
+#endif
+
+	timer->m_running = false;
+
+	return true;
+}
+
+int CReactor::addEvent()
+{
+#if defined(__linux__)
+	int fd = ::eventfd(0U, EFD_NONBLOCK | EFD_CLOEXEC);
+	if (fd < 0) {
+		LogError("Cannot create the event, err: %d", errno);
+		return -1;
+	}
+
+	epoll_event ev;
+	::memset(&ev, 0x00, sizeof(epoll_event));
+	ev.events  = EPOLLIN;
+	ev.data.fd = fd;
+
+	if (::epoll_ctl(m_fd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+		LogError("Cannot add the event to epoll, err: %d", errno);
+		::close(fd);
+		return -1;
+	}
+
+	m_events.push_back(fd);
+#else
+	m_events.push_back(new std::atomic<bool>(false));
+#endif
+
+	return int(m_events.size()) - 1;
+}
+
+void CReactor::signal(int n)
+{
+	assert(n >= 0 && n < int(m_events.size()));
+
+#if defined(__linux__)
+	uint64_t value = 1U;
+	if (::write(m_events.at(n), &value, sizeof(uint64_t)) != ssize_t(sizeof(uint64_t)))
+		LogError("Cannot signal the event, err: %d", errno);
+#else
+	m_events.at(n)->store(true, std::memory_order_release);
+#endif
+}
+
+bool CReactor::hasSignalled(int n)
+{
+	assert(n >= 0 && n < int(m_events.size()));
+
+#if defined(__linux__)
+	uint64_t value = 0U;
+	return ::read(m_events.at(n), &value, sizeof(uint64_t)) == ssize_t(sizeof(uint64_t)) && value > 0U;
+#else
+	return m_events.at(n)->exchange(false, std::memory_order_acquire);
+#endif
+}
+
+void CReactor::wait(unsigned int ms)
+{
+#if defined(__linux__)
+	epoll_event events[MAX_EVENTS];
+
+	int ret = ::epoll_wait(m_fd, events, MAX_EVENTS, int(ms));
+	if (ret < 0 && errno != EINTR)
+		LogError("Error returned from epoll_wait, err: %d", errno);
+#else
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	for (std::vector<CReactorTimer*>::const_iterator it = m_timers.begin(); it != m_timers.end(); ++it) {
+		if (!(*it)->m_running)
+			continue;
+
+		if ((*it)->m_deadline <= now) {
+			ms = 0U;
+		} else {
+			unsigned int remaining = (unsigned int)std::chrono::duration_cast<std::chrono::milliseconds>((*it)->m_deadline - now).count();
+			if (remaining < ms)
+				ms = remaining;
+		}
+	}
+
+	for (std::vector<std::atomic<bool>*>::const_iterator it = m_events.begin(); it != m_events.end(); ++it) {
+		if ((*it)->load(std::memory_order_acquire))
+			ms = 0U;
+		else if (ms > EVENT_POLL_PER)
+			ms = EVENT_POLL_PER;
+	}
+
+	if (m_sockets.empty()) {
+		if (ms > 0U)
+			CThread::sleep(ms);
+		return;
+	}
+
+	fd_set readFds;
+	FD_ZERO(&readFds);
+
+	int maxFd = 0;
+	for (std::vector<int>::const_iterator it = m_sockets.begin(); it != m_sockets.end(); ++it) {
+#if defined(_WIN32) || defined(_WIN64)
+		FD_SET((unsigned int)*it, &readFds);
+#else
+		FD_SET(*it, &readFds);
+#endif
+		if (*it > maxFd)
+			maxFd = *it;
+	}
+
+	timeval tv;
+	tv.tv_sec  = ms / 1000U;
+	tv.tv_usec = (ms % 1000U) * 1000U;
+
+	::select(maxFd + 1, &readFds, NULL, NULL, &tv);
+#endif
+}
+
+void CReactor::close()
+{
+	for (std::vector<CReactorTimer*>::iterator it = m_timers.begin(); it != m_timers.end(); ++it) {
+#if defined(__linux__)
+		::close((*it)->m_fd);
+#endif
+		delete *it;
+	}
+
+	m_timers.clear();
+
+	for (unsigned int i = 0U; i < m_events.size(); i++) {
+#if defined(__linux__)
+		::close(m_events.at(i));
+#else
+		delete m_events.at(i);
+#endif
+	}
+
+	m_events.clear();
+	m_sockets.clear();
+
+#if defined(__linux__)
+	if (m_fd >= 0) {
+		::close(m_fd);
+		m_fd = -1;
+	}
+#endif
+}
@@ -0,0 +1,84 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(REACTOR_H)
+#define	REACTOR_H
+
+#include <vector>
+#include <chrono>
+#include <atomic>
+
+// Blocks the main loop until a registered socket is readable, a timer fires or
+// another thread signals an event. On Linux this is epoll with one timerfd per
+// timer and one eventfd per event, elsewhere select() with software timers and
+// events that are polled every EVENT_POLL_PER ms.
+class CReactorTimer {
+public:
+	CReactorTimer() :
+	m_ms(0U),
+	m_fd(-1),
+	m_running(false),
+	m_deadline()
+	{
+	}
+
+	unsigned int m_ms;
+	int          m_fd;
+	bool         m_running;
+	std::chrono::steady_clock::time_point m_deadline;
+};
+
+class CReactor {
+public:
+	CReactor();
+	~CReactor();
+
+	bool open();
+
+	bool addSocket(int fd);
+	void removeSocket(int fd);
+
+	// One shot timers, started again by the user after each expiry
+	int  addTimer(unsigned int ms);
+	void startTimer(int timer);
+	void startTimer(int timer, const std::chrono::steady_clock::time_point& deadline);
+	void stopTimer(int timer);
+	bool isRunning(int timer) const;
+	bool hasExpired(int timer);
+
+	// Events may be signalled from any thread
+	int  addEvent();
+	void signal(int event);
+	bool hasSignalled(int event);
+
+	void wait(unsigned int ms);
+
+	void close();
+
+private:
+	int                         m_fd;
+	std::vector<int>            m_sockets;
+	std::vector<CReactorTimer*> m_timers;
+#if defined(__linux__)
+	std::vector<int>            m_events;
+#else
+	std::vector<std::atomic<bool>*> m_events;
+#endif
+};
+
+#endif
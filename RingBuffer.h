@@ -24,12 +24,19 @@
 #include <cstdio>
 #include <cassert>
 #include <cstring>
+#include <atomic>
 
+// The length is rounded up to a power of two so the read and write positions
+// can run freely and be masked into the buffer. With spsc set, one thread may
+// add data while another gets it without any locking, an overflow then drops
+// the new data instead of clearing the buffer under the reader.
 template<class T> class CRingBuffer {
 public:
-	CRingBuffer(unsigned int length, const char* name) :
-	m_length(length),
+	CRingBuffer(unsigned int length, const char* name, bool spsc = false) :
+	m_length(1U),
+	m_mask(0U),
 	m_name(name),
+	m_spsc(spsc),
 	m_buffer(NULL),
 	m_iPtr(0U),
 	m_oPtr(0U)
@@ -37,7 +44,11 @@ public:
 		assert(length > 0U);
 		assert(name != NULL);
 
-		m_buffer = new T[length];
+		while (m_length < length)
+			m_length <<= 1;
+		m_mask = m_length - 1U;
+
+		m_buffer = new T[m_length];
 
 		::memset(m_buffer, 0x00, m_length * sizeof(T));
 	}
@@ -49,83 +60,76 @@ public:
 
 	bool addData(const T* buffer, unsigned int nSamples)
 	{
-		if (nSamples >= freeSpace()) {
-			LogError("%s buffer overflow, clearing the buffer. (%u >= %u)", m_name, nSamples, freeSpace());
-			clear();
+		unsigned int iPtr = m_iPtr.load(std::memory_order_relaxed);
+		unsigned int oPtr = m_oPtr.load(std::memory_order_acquire);
+
+		unsigned int space = m_length - (iPtr - oPtr);
+		if (nSamples > space) {
+			if (m_spsc) {
+				LogError("%s buffer overflow, dropping the data. (%u > %u)", m_name, nSamples, space);
+			} else {
+				LogError("%s buffer overflow, clearing the buffer. (%u > %u)", m_name, nSamples, space);
+				clear();
+			}
 			return false;
 		}
 
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			m_buffer[m_iPtr++] = buffer[i];
+		copyIn(iPtr, buffer, nSamples);
 
-			if (m_iPtr == m_length)
-				m_iPtr = 0U;
-		}
+		m_iPtr.store(iPtr + nSamples, std::memory_order_release);
 
 		return true;
 	}
 
 	bool getData(T* buffer, unsigned int nSamples)
 	{
-		if (dataSize() < nSamples) {
-			LogError("**** Underflow in %s ring buffer, %u < %u", m_name, dataSize(), nSamples);
+		unsigned int oPtr = m_oPtr.load(std::memory_order_relaxed);
+		unsigned int iPtr = m_iPtr.load(std::memory_order_acquire);
+
+		if ((iPtr - oPtr) < nSamples) {
+			LogError("**** Underflow in %s ring buffer, %u < %u", m_name, iPtr - oPtr, nSamples);
 			return false;
 		}
 
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			buffer[i] = m_buffer[m_oPtr++];
+		copyOut(oPtr, buffer, nSamples);
 
-			if (m_oPtr == m_length)
-				m_oPtr = 0U;
-		}
+		m_oPtr.store(oPtr + nSamples, std::memory_order_release);
 
 		return true;
 	}
 
 	bool peek(T* buffer, unsigned int nSamples)
 	{
-		if (dataSize() < nSamples) {
-			LogError("**** Underflow peek in %s ring buffer, %u < %u", m_name, dataSize(), nSamples);
+		unsigned int oPtr = m_oPtr.load(std::memory_order_relaxed);
+		unsigned int iPtr = m_iPtr.load(std::memory_order_acquire);
+
+		if ((iPtr - oPtr) < nSamples) {
+			LogError("**** Underflow peek in %s ring buffer, %u < %u", m_name, iPtr - oPtr, nSamples);
 			return false;
 		}
 
-		unsigned int ptr = m_oPtr;
-		for (unsigned int i = 0U; i < nSamples; i++) {
-			buffer[i] = m_buffer[ptr++];
-
-			if (ptr == m_length)
-				ptr = 0U;
-		}
+		copyOut(oPtr, buffer, nSamples);
 
 		return true;
 	}
 
+	// Discards everything written so far, in SPSC mode only the reader may call this
 	void clear()
 	{
-		m_iPtr = 0U;
-		m_oPtr = 0U;
-
-		::memset(m_buffer, 0x00, m_length * sizeof(T));
+		m_oPtr.store(m_iPtr.load(std::memory_order_acquire), std::memory_order_release);
 	}
 
 	unsigned int freeSpace() const
 	{
-		unsigned int len = m_length;
-
-		if (m_oPtr > m_iPtr)
-			len = m_oPtr - m_iPtr;
-		else if (m_iPtr > m_oPtr)
-			len = m_length - (m_iPtr - m_oPtr);
-
-		if (len > m_length)
-			len = 0U;
-
-		return len;
+		return m_length - dataSize();
 	}
 
 	unsigned int dataSize() const
 	{
-		return m_length - freeSpace();
+		unsigned int oPtr = m_oPtr.load(std::memory_order_acquire);
+		unsigned int iPtr = m_iPtr.load(std::memory_order_acquire);
+
+		return iPtr - oPtr;
 	}
 
 	bool hasSpace(unsigned int length) const
@@ -135,20 +139,57 @@ public:
 
 	bool hasData() const
 	{
-		return m_oPtr != m_iPtr;
+		return dataSize() > 0U;
 	}
 
 	bool isEmpty() const
 	{
-		return m_oPtr == m_iPtr;
+		return dataSize() == 0U;
 	}
 
 private:
 	unsigned int m_length;
+	unsigned int m_mask;
 	const char*  m_name;
+	bool         m_spsc;
 	T*           m_buffer;
-	unsigned int m_iPtr;
-	unsigned int m_oPtr;
+	std::atomic<unsigned int> m_iPtr;
+	std::atomic<unsigned int> m_oPtr;
+
+	// Single elements, as the frame queues move them, are copied without a call to memcpy
+	void copyIn(unsigned int ptr, const T* buffer, unsigned int nSamples)
+	{
+		if (nSamples == 1U) {
+			m_buffer[ptr & m_mask] = buffer[0U];
+			return;
+		}
+
+		unsigned int pos   = ptr & m_mask;
+		unsigned int first = m_length - pos;
+		if (first > nSamples)
+			first = nSamples;
+
+		::memcpy(m_buffer + pos, buffer, first * sizeof(T));
+		if (nSamples > first)
+			::memcpy(m_buffer, buffer + first, (nSamples - first) * sizeof(T));
+	}
+
+	void copyOut(unsigned int ptr, T* buffer, unsigned int nSamples) const
+	{
+		if (nSamples == 1U) {
+			buffer[0U] = m_buffer[ptr & m_mask];
+			return;
+		}
+
+		unsigned int pos   = ptr & m_mask;
+		unsigned int first = m_length - pos;
+		if (first > nSamples)
+			first = nSamples;
+
+		::memcpy(buffer, m_buffer + pos, first * sizeof(T));
+		if (nSamples > first)
+			::memcpy(buffer + first, m_buffer, (nSamples - first) * sizeof(T));
+	}
 };
 
 #endif
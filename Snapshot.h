@@ -0,0 +1,90 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(SNAPSHOT_H)
+#define	SNAPSHOT_H
+
+#include "Thread.h"
+
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+
+// An immutable object replaced as a whole. Readers pin the current copy
+// without locking or waiting: each one counts itself into the reader slot of
+// the epoch it started in. The single writer publishes a new copy, moves the
+// epoch on, and frees the old copy once the slot of the old epoch is empty.
+template<class T> class CSnapshot {
+public:
+	CSnapshot(T* current) :
+	m_current(current),
+	m_epoch(0U)
+	{
+		assert(current != NULL);
+
+		m_readers[0U] = 0U;
+		m_readers[1U] = 0U;
+	}
+
+	~CSnapshot()
+	{
+		delete m_current.load();
+	}
+
+	// Returns the current copy, which stays valid until release() is called with the same epoch
+	const T* acquire(unsigned int& epoch)
+	{
+		for (;;) {
+			epoch = m_epoch.load();
+			m_readers[epoch & 0x01U]++;
+
+			// A writer that moved the epoch on may already have found this slot empty
+			if (m_epoch.load() == epoch)
+				return m_current.load();
+
+			m_readers[epoch & 0x01U]--;
+		}
+	}
+
+	void release(unsigned int epoch)
+	{
+		m_readers[epoch & 0x01U]--;
+	}
+
+	// Only one thread may publish, it waits for the readers of the old copy before freeing it
+	void publish(T* next)
+	{
+		assert(next != NULL);
+
+		T* old = m_current.exchange(next);
+
+		unsigned int epoch = m_epoch++;
+		while (m_readers[epoch & 0x01U].load() != 0U)
+			CThread::sleep(1U);
+
+		delete old;
+	}
+
+private:
+	std::atomic<T*>           m_current;
+	std::atomic<unsigned int> m_epoch;
+	std::atomic<unsigned int> m_readers[2U];
+};
+
+#endif
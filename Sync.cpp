@@ -21,6 +21,7 @@
 
 #include "DMRDefines.h"
 #include "NXDNDefines.h"
+#include "DMRBurst.h"
 
 #include <cstdio>
 #include <cassert>
@@ -28,28 +29,12 @@
 
 void CSync::addDMRDataSync(unsigned char* data, bool duplex)
 {
-	assert(data != NULL);
-
-	if (duplex) {
-		for (unsigned int i = 0U; i < 7U; i++)
-			data[i + 13U] = (data[i + 13U] & ~SYNC_MASK[i]) | BS_SOURCED_DATA_SYNC[i];
-	} else {
-		for (unsigned int i = 0U; i < 7U; i++)
-			data[i + 13U] = (data[i + 13U] & ~SYNC_MASK[i]) | MS_SOURCED_DATA_SYNC[i];
-	}
+	CDMRBurst::addDataSync(data, duplex);
 }
 
 void CSync::addDMRAudioSync(unsigned char* data, bool duplex)
 {
-	assert(data != NULL);
-
-	if (duplex) {
-		for (unsigned int i = 0U; i < 7U; i++)
-			data[i + 13U] = (data[i + 13U] & ~SYNC_MASK[i]) | BS_SOURCED_AUDIO_SYNC[i];
-	} else {
-		for (unsigned int i = 0U; i < 7U; i++)
-			data[i + 13U] = (data[i + 13U] & ~SYNC_MASK[i]) | MS_SOURCED_AUDIO_SYNC[i];
-	}
+	CDMRBurst::addAudioSync(data, duplex);
 }
 
 void CSync::addNXDNSync(unsigned char* data)
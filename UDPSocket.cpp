@@ -17,6 +17,7 @@
  */
 
 #include "UDPSocket.h"
+#include "Reactor.h"
 #include "Log.h"
 
 #include <cassert>
@@ -30,7 +31,11 @@
 CUDPSocket::CUDPSocket(const std::string& address, unsigned int port) :
 m_address(address),
 m_port(port),
-m_fd(-1)
+m_fd(-1),
+m_reactor(NULL),
+m_connected(false),
+m_peerAddress(),
+m_peerPort(0U)
 {
 	assert(!address.empty());
 
@@ -45,7 +50,11 @@ m_fd(-1)
 CUDPSocket::CUDPSocket(unsigned int port) :
 m_address(),
 m_port(port),
-m_fd(-1)
+m_fd(-1),
+m_reactor(NULL),
+m_connected(false),
+m_peerAddress(),
+m_peerPort(0U)
 {
 #if defined(_WIN32) || defined(_WIN64)
 	WSAData data;
@@ -102,6 +111,11 @@ in_addr CUDPSocket::lookup(const std::string& hostname)
 #endif
 }
 
+void CUDPSocket::setReactor(CReactor* reactor)
+{
+	m_reactor = reactor;
+}
+
 bool CUDPSocket::open()
 {
 	m_fd = ::socket(PF_INET, SOCK_DGRAM, 0);
@@ -153,6 +167,9 @@ bool CUDPSocket::open()
 		}
 	}
 
+	if (m_reactor != NULL)
+		return m_reactor->addSocket(m_fd);
+
 	return true;
 }
 
@@ -161,14 +178,15 @@ int CUDPSocket::read(unsigned char* buffer, unsigned int length, in_addr& addres
 	assert(buffer != NULL);
 	assert(length > 0U);
 
+	if (m_fd < 0)
+		return -1;
+
+	sockaddr_in addr;
+#if defined(_WIN32) || defined(_WIN64)
 	// Check that the readfrom() won't block
 	fd_set readFds;
 	FD_ZERO(&readFds);
-#if defined(_WIN32) || defined(_WIN64)
 	FD_SET((unsigned int)m_fd, &readFds);
-#else
-	FD_SET(m_fd, &readFds);
-#endif
 
 	// Return immediately
 	timeval tv;
@@ -177,38 +195,36 @@ int CUDPSocket::read(unsigned char* buffer, unsigned int length, in_addr& addres
 
 	int ret = ::select(m_fd + 1, &readFds, NULL, NULL, &tv);
 	if (ret < 0) {
-#if defined(_WIN32) || defined(_WIN64)
 		LogError("Error returned from UDP select, err: %lu", ::GetLastError());
-#else
-		LogError("Error returned from UDP select, err: %d", errno);
-#endif
 		return -1;
 	}
 
 	if (ret == 0)
 		return 0;
 
-	sockaddr_in addr;
-#if defined(_WIN32) || defined(_WIN64)
 	int size = sizeof(sockaddr_in);
-#else
-	socklen_t size = sizeof(sockaddr_in);
-#endif
-
-#if defined(_WIN32) || defined(_WIN64)
 	int len = ::recvfrom(m_fd, (char*)buffer, length, 0, (sockaddr *)&addr, &size);
-#else
-	ssize_t len = ::recvfrom(m_fd, (char*)buffer, length, 0, (sockaddr *)&addr, &size);
-#endif
 	if (len <= 0) {
-#if defined(_WIN32) || defined(_WIN64)
 		LogError("Error returned from recvfrom, err: %lu", ::GetLastError());
+		return -1;
+	}
 #else
+	// A non blocking receive saves the select() on every datagram
+	socklen_t size = sizeof(sockaddr_in);
+	ssize_t len = ::recvfrom(m_fd, (char*)buffer, length, MSG_DONTWAIT, (sockaddr *)&addr, &size);
+	if (len < 0) {
+		// An ICMP error from a connected peer is reported here, it is not a socket failure
+		if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNREFUSED)
+			return 0;
+
 		LogError("Error returned from recvfrom, err: %d", errno);
-#endif
 		return -1;
 	}
 
+	if (len == 0)
+		return 0;
+#endif
+
 	address = addr.sin_addr;
 	port    = ntohs(addr.sin_port);
 
@@ -230,7 +246,16 @@ bool CUDPSocket::write(const unsigned char* buffer, unsigned int length, const i
 #if defined(_WIN32) || defined(_WIN64)
 	int ret = ::sendto(m_fd, (char *)buffer, length, 0, (sockaddr *)&addr, sizeof(sockaddr_in));
 #else
-	ssize_t ret = ::sendto(m_fd, (char *)buffer, length, 0, (sockaddr *)&addr, sizeof(sockaddr_in));
+	ssize_t ret;
+	if (isPeer(address, port)) {
+		ret = ::send(m_fd, (char *)buffer, length, 0);
+
+		// A pending ICMP error from the peer fails one send, the datagram was not sent
+		if (ret < 0 && errno == ECONNREFUSED)
+			ret = ::send(m_fd, (char *)buffer, length, 0);
+	} else {
+		ret = ::sendto(m_fd, (char *)buffer, length, 0, (sockaddr *)&addr, sizeof(sockaddr_in));
+	}
 #endif
 	if (ret < 0) {
 #if defined(_WIN32) || defined(_WIN64)
@@ -252,11 +277,181 @@ bool CUDPSocket::write(const unsigned char* buffer, unsigned int length, const i
 	return true;
 }
 
+int CUDPSocket::read(CUDPDatagram* datagrams, unsigned int count)
+{
+	assert(datagrams != NULL);
+	assert(count > 0U);
+
+	if (m_fd < 0)
+		return -1;
+
+#if defined(__linux__)
+	mmsghdr msgs[UDP_BATCH_SIZE];
+	iovec iovecs[UDP_BATCH_SIZE];
+	sockaddr_in addrs[UDP_BATCH_SIZE];
+
+	if (count > UDP_BATCH_SIZE)
+		count = UDP_BATCH_SIZE;
+
+	::memset(msgs, 0x00, count * sizeof(mmsghdr));
+	for (unsigned int i = 0U; i < count; i++) {
+		iovecs[i].iov_base = datagrams[i].m_data;
+		iovecs[i].iov_len  = UDP_DATAGRAM_LENGTH;
+
+		msgs[i].msg_hdr.msg_iov     = &iovecs[i];
+		msgs[i].msg_hdr.msg_iovlen  = 1U;
+		msgs[i].msg_hdr.msg_name    = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+	}
+
+	int ret = ::recvmmsg(m_fd, msgs, count, MSG_DONTWAIT, NULL);
+	if (ret < 0) {
+		if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNREFUSED)
+			return 0;
+
+		LogError("Error returned from recvmmsg, err: %d", errno);
+		return -1;
+	}
+
+	for (int i = 0; i < ret; i++) {
+		datagrams[i].m_length  = msgs[i].msg_len;
+		datagrams[i].m_address = addrs[i].sin_addr;
+		datagrams[i].m_port    = ntohs(addrs[i].sin_port);
+	}
+
+	return ret;
+#else
+	unsigned int n = 0U;
+	while (n < count) {
+		int len = read(datagrams[n].m_data, UDP_DATAGRAM_LENGTH, datagrams[n].m_address, datagrams[n].m_port);
+		if (len < 0)
+			return n > 0U ? int(n) : -1;
+		if (len == 0)
+			break;
+
+		datagrams[n].m_length = len;
+		n++;
+	}
+
+	return int(n);
+#endif
+}
+
+bool CUDPSocket::write(const CUDPDatagram* datagrams, unsigned int count)
+{
+	assert(datagrams != NULL);
+
+#if defined(__linux__)
+	mmsghdr msgs[UDP_BATCH_SIZE];
+	iovec iovecs[UDP_BATCH_SIZE];
+	sockaddr_in addrs[UDP_BATCH_SIZE];
+
+	while (count > 0U) {
+		unsigned int n = count > UDP_BATCH_SIZE ? UDP_BATCH_SIZE : count;
+
+		::memset(msgs, 0x00, n * sizeof(mmsghdr));
+		for (unsigned int i = 0U; i < n; i++) {
+			assert(datagrams[i].m_length > 0U && datagrams[i].m_length <= UDP_DATAGRAM_LENGTH);
+
+			iovecs[i].iov_base = (void*)datagrams[i].m_data;
+			iovecs[i].iov_len  = datagrams[i].m_length;
+
+			msgs[i].msg_hdr.msg_iov    = &iovecs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1U;
+
+			if (!isPeer(datagrams[i].m_address, datagrams[i].m_port)) {
+				::memset(&addrs[i], 0x00, sizeof(sockaddr_in));
+				addrs[i].sin_family = AF_INET;
+				addrs[i].sin_addr   = datagrams[i].m_address;
+				addrs[i].sin_port   = htons(datagrams[i].m_port);
+
+				msgs[i].msg_hdr.msg_name    = &addrs[i];
+				msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+			}
+		}
+
+		int ret = ::sendmmsg(m_fd, msgs, n, 0);
+		if (ret < 0 && errno == ECONNREFUSED)
+			ret = ::sendmmsg(m_fd, msgs, n, 0);
+		if (ret <= 0) {
+			LogError("Error returned from sendmmsg, err: %d", errno);
+			return false;
+		}
+
+		for (int i = 0; i < ret; i++) {
+			if (msgs[i].msg_len != datagrams[i].m_length)
+				return false;
+		}
+
+		datagrams += ret;
+		count     -= ret;
+	}
+
+	return true;
+#else
+	for (unsigned int i = 0U; i < count; i++) {
+		if (!write(datagrams[i].m_data, datagrams[i].m_length, datagrams[i].m_address, datagrams[i].m_port))
+			return false;
+	}
+
+	return true;
+#endif
+}
+
+bool CUDPSocket::connect(const in_addr& address, unsigned int port)
+{
+	assert(port > 0U);
+
+	if (m_fd < 0)
+		return false;
+
+	sockaddr_in addr;
+	::memset(&addr, 0x00, sizeof(sockaddr_in));
+
+	addr.sin_family = AF_INET;
+	addr.sin_addr   = address;
+	addr.sin_port   = htons(port);
+
+	if (::connect(m_fd, (sockaddr *)&addr, sizeof(sockaddr_in)) == -1) {
+#if defined(_WIN32) || defined(_WIN64)
+		LogError("Cannot connect the UDP socket, err: %lu", ::GetLastError());
+#else
+		LogError("Cannot connect the UDP socket, err: %d", errno);
+#endif
+		return false;
+	}
+
+	m_connected   = true;
+	m_peerAddress = address;
+	m_peerPort    = port;
+
+	return true;
+}
+
+bool CUDPSocket::isPeer(const in_addr& address, unsigned int port) const
+{
+	return m_connected && m_peerAddress.s_addr == address.s_addr && m_peerPort == port;
+}
+
 void CUDPSocket::close()
 {
+	if (m_fd < 0)
+		return;
+
+	if (m_reactor != NULL)
+		m_reactor->removeSocket(m_fd);
+
 #if defined(_WIN32) || defined(_WIN64)
 	::closesocket(m_fd);
 #else
 	::close(m_fd);
 #endif
+
+	m_fd        = -1;
+	m_connected = false;
+}
+
+int CUDPSocket::getFd() const
+{
+	return m_fd;
 }
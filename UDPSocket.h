@@ -34,25 +34,56 @@
 #include <winsock.h>
 #endif
 
+class CReactor;
+
+const unsigned int UDP_BATCH_SIZE      = 16U;
+const unsigned int UDP_DATAGRAM_LENGTH = 500U;
+
+// One datagram of a batch read or write
+class CUDPDatagram {
+public:
+	unsigned char m_data[UDP_DATAGRAM_LENGTH];
+	unsigned int  m_length;
+	in_addr       m_address;
+	unsigned int  m_port;
+};
+
 class CUDPSocket {
 public:
 	CUDPSocket(const std::string& address, unsigned int port = 0U);
 	CUDPSocket(unsigned int port = 0U);
 	~CUDPSocket();
 
+	void setReactor(CReactor* reactor);
+
 	bool open();
 
 	int  read(unsigned char* buffer, unsigned int length, in_addr& address, unsigned int& port);
 	bool write(const unsigned char* buffer, unsigned int length, const in_addr& address, unsigned int port);
 
+	// Batches use recvmmsg()/sendmmsg() where available, one call per datagram elsewhere
+	int  read(CUDPDatagram* datagrams, unsigned int count);
+	bool write(const CUDPDatagram* datagrams, unsigned int count);
+
+	// Datagrams to a connected peer skip the route lookup, and only that peer can be received from
+	bool connect(const in_addr& address, unsigned int port);
+
 	void close();
 
+	int  getFd() const;
+
 	static in_addr lookup(const std::string& hostName);
 
 private:
 	std::string    m_address;
 	unsigned short m_port;
 	int            m_fd;
+	CReactor*      m_reactor;
+	bool           m_connected;
+	in_addr        m_peerAddress;
+	unsigned int   m_peerPort;
+
+	bool isPeer(const in_addr& address, unsigned int port) const;
 };
 
 #endif
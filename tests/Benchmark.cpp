@@ -0,0 +1,790 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "RefBPTC19696.h"
+#include "RefRS129.h"
+#include "RefNXDNCRC.h"
+#include "RefNXDNConvolution.h"
+#include "RefIdTable.h"
+#include "RefModeConv.h"
+#include "RefRingBuffer.h"
+#include "HammingCodes.h"
+#include "NXDNCallTemplate.h"
+#include "BPTC19696.h"
+#include "RS129.h"
+#include "Golay24128.h"
+#include "NXDNCRC.h"
+#include "NXDNConvolution.h"
+#include "IdTable.h"
+#include "ModeConv.h"
+#include "RingBuffer.h"
+#include "NXDNDefines.h"
+#include "NXDNLayer3.h"
+#include "NXDNSACCH.h"
+#include "NXDNLICH.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Throughput of the codec paths against the code they replaced, run with
+// "make bench" on the target; a section name as argument runs that one only
+
+// Results are added in here so the timed work is not optimised away
+static volatile unsigned int g_sink = 0U;
+
+// The mean time of one call of f over count calls, in nanoseconds
+template<typename F> static double nsPerCall(unsigned int count, F f)
+{
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	for (unsigned int i = 0U; i < count; i++)
+		f(i);
+
+	std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+	return elapsed.count() / double(count);
+}
+
+static void report(const char* name, double before, double after)
+{
+	::printf("%-40s %9.1f ns %9.1f ns %7.1fx %9.2f M/s\n", name, before, after, before / after, 1000.0 / after);
+}
+
+// The LICH and SACCH of a voice frame as every frame built them before the call templates
+static void encodeVoice(unsigned char* data, unsigned short srcId, unsigned short dstId, unsigned int seqNo)
+{
+	static const unsigned char STRUCTURES[] = {NXDN_SR_1_4, NXDN_SR_2_4, NXDN_SR_3_4, NXDN_SR_4_4};
+
+	CNXDNLICH lich;
+	lich.setRFCT(NXDN_LICH_RFCT_RDCH);
+	lich.setFCT(NXDN_LICH_USC_SACCH_SS);
+	lich.setOption(NXDN_LICH_STEAL_NONE);
+	lich.setDirection(NXDN_LICH_DIRECTION_INBOUND);
+	data[0U] = lich.getRaw();
+
+	CNXDNLayer3 layer3;
+	layer3.setMessageType(NXDN_MESSAGE_TYPE_VCALL);
+	layer3.setSourceUnitId(srcId);
+	layer3.setDestinationGroupId(dstId);
+	layer3.setGroup(true);
+	layer3.setDataBlocks(0U);
+
+	unsigned char message[3U];
+	layer3.encode(message, 18U, (seqNo % 4U) * 18U);
+
+	CNXDNSACCH sacch;
+	sacch.setRAN(0x01U);
+	sacch.setStructure(STRUCTURES[seqNo % 4U]);
+	sacch.setData(message);
+	sacch.getRaw(data + 1U);
+}
+
+static bool benchNXDNTemplate()
+{
+	const unsigned int COUNT = 200000U;
+
+	CNXDNCallTemplate temp;
+	temp.setCall(3100U, 20U, 0x01U);
+
+	for (unsigned int seqNo = 0U; seqNo < 4U; seqNo++) {
+		unsigned char before[33U], after[33U];
+		::memset(before, 0x00U, 33U);
+		::memset(after, 0x00U, 33U);
+
+		encodeVoice(before, 3100U, 20U, seqNo);
+		temp.getVoice(after, seqNo);
+
+		if (::memcmp(before, after, 33U) != 0) {
+			::printf("NXDN voice frame %u differs from the template\n", seqNo);
+			return false;
+		}
+	}
+
+	unsigned char data[33U];
+
+	double before = nsPerCall(COUNT, [&](unsigned int i) {
+		encodeVoice(data, 3100U, 20U, i);
+		g_sink += data[1U];
+	});
+
+	double after = nsPerCall(COUNT, [&](unsigned int i) {
+		temp.getVoice(data, i);
+		g_sink += data[1U];
+	});
+
+	report("NXDN voice frame LICH and SACCH", before, after);
+
+	return true;
+}
+
+static bool benchBPTC()
+{
+	const unsigned int COUNT  = 100000U;
+	const unsigned int BLOCKS = 256U;
+
+	// Valid blocks, and the same blocks with a single bit error
+	unsigned char valid[BLOCKS][33U];
+	unsigned char bursts[BLOCKS][33U];
+	CBPTC19696 bptc;
+	::srand(1U);
+	for (unsigned int i = 0U; i < BLOCKS; i++) {
+		unsigned char data[12U];
+		for (unsigned int n = 0U; n < 12U; n++)
+			data[n] = ::rand() & 0xFFU;
+
+		::memset(valid[i], 0x00U, 33U);
+		bptc.encode(data, valid[i]);
+		::memcpy(bursts[i], valid[i], 33U);
+
+		unsigned int bit = ::rand() % 196U;
+		bit += bit < 98U ? 0U : 166U - 98U;
+		bursts[i][bit / 8U] ^= 0x80U >> (bit % 8U);
+	}
+
+	CRefBPTC19696 ref;
+	for (unsigned int i = 0U; i < BLOCKS; i++) {
+		unsigned char before[12U], after[12U];
+		ref.decode(bursts[i], before);
+		bptc.decode(bursts[i], after);
+
+		unsigned char burst1[33U], burst2[33U];
+		::memset(burst1, 0x00U, 33U);
+		::memset(burst2, 0x00U, 33U);
+		ref.encode(before, burst1);
+		bptc.encode(after, burst2);
+
+		if (::memcmp(before, after, 12U) != 0 || ::memcmp(burst1, burst2, 33U) != 0) {
+			::printf("BPTC(196,96) block %u differs from the reference\n", i);
+			return false;
+		}
+	}
+
+	unsigned char data[12U];
+	unsigned char burst[33U];
+	::memset(burst, 0x00U, 33U);
+
+	double before = nsPerCall(COUNT, [&](unsigned int i) {
+		ref.decode(valid[i % BLOCKS], data);
+		g_sink += data[0U];
+	});
+
+	double after = nsPerCall(COUNT, [&](unsigned int i) {
+		bptc.decode(valid[i % BLOCKS], data);
+		g_sink += data[0U];
+	});
+
+	report("BPTC(196,96) decode", before, after);
+
+	before = nsPerCall(COUNT, [&](unsigned int i) {
+		ref.decode(bursts[i % BLOCKS], data);
+		g_sink += data[0U];
+	});
+
+	after = nsPerCall(COUNT, [&](unsigned int i) {
+		bptc.decode(bursts[i % BLOCKS], data);
+		g_sink += data[0U];
+	});
+
+	report("BPTC(196,96) decode, one bit error", before, after);
+
+	before = nsPerCall(COUNT, [&](unsigned int i) {
+		ref.encode(bursts[i % BLOCKS] + 1U, burst);
+		g_sink += burst[0U];
+	});
+
+	after = nsPerCall(COUNT, [&](unsigned int i) {
+		bptc.encode(bursts[i % BLOCKS] + 1U, burst);
+		g_sink += burst[0U];
+	});
+
+	report("BPTC(196,96) encode", before, after);
+
+	return true;
+}
+
+// Decoding every input word, from bool arrays and from packed words
+static bool benchHamming()
+{
+	for (const CHammingCode& code : HAMMING_CODES) {
+		unsigned int words = 1U << code.m_length;
+
+		std::vector<bool*> inputs(words);
+		bool* arrays = new bool[words * code.m_length];
+		for (unsigned int word = 0U; word < words; word++) {
+			inputs[word] = arrays + word * code.m_length;
+			wordToBools(word, inputs[word], code.m_length);
+		}
+
+		// The bool decoders correct in place, so each pass works on a copy
+		bool d[17U];
+		double before = nsPerCall(4U * words, [&](unsigned int i) {
+			::memcpy(d, inputs[i % words], code.m_length);
+			g_sink += code.m_decodeBool(d) ? 1U : 0U;
+		});
+
+		double after = nsPerCall(4U * words, [&](unsigned int i) {
+			unsigned int word = i % words;
+			g_sink += code.m_decodeWord(word) ? word : 0U;
+		});
+
+		delete[] arrays;
+
+		std::string name = std::string(code.m_name) + " decode";
+		report(name.c_str(), before, after);
+	}
+
+	return true;
+}
+
+// Encoding and checking the parity of a full LC
+static bool benchRS129()
+{
+	const unsigned int COUNT = 1000000U;
+	const unsigned int LCS   = 256U;
+
+	// Half of the LCs carry a bit error
+	unsigned char lcs[LCS][12U];
+	::srand(1U);
+	for (unsigned int i = 0U; i < LCS; i++) {
+		for (unsigned int n = 0U; n < 9U; n++)
+			lcs[i][n] = ::rand() & 0xFFU;
+
+		unsigned char parity[4U];
+		CRS129::encode(lcs[i], 9U, parity);
+		lcs[i][9U]  = parity[2U];
+		lcs[i][10U] = parity[1U];
+		lcs[i][11U] = parity[0U];
+
+		if ((i & 0x01U) != 0U)
+			lcs[i][::rand() % 12U] ^= 0x01U << (::rand() % 8U);
+	}
+
+	for (unsigned int i = 0U; i < LCS; i++) {
+		unsigned char before[4U], after[4U];
+		CRefRS129::encode(lcs[i], 9U, before);
+		CRS129::encode(lcs[i], 9U, after);
+
+		if (::memcmp(before + 0U, after + 0U, 3U) != 0 || CRefRS129::check(lcs[i]) != CRS129::check(lcs[i])) {
+			::printf("RS(12,9) LC %u differs from the reference\n", i);
+			return false;
+		}
+	}
+
+	unsigned char parity[4U];
+
+	double before = nsPerCall(COUNT, [&](unsigned int i) {
+		CRefRS129::encode(lcs[i % LCS], 9U, parity);
+		g_sink += parity[0U];
+	});
+
+	double after = nsPerCall(COUNT, [&](unsigned int i) {
+		CRS129::encode(lcs[i % LCS], 9U, parity);
+		g_sink += parity[0U];
+	});
+
+	report("RS(12,9) encode", before, after);
+
+	before = nsPerCall(COUNT, [&](unsigned int i) {
+		g_sink += CRefRS129::check(lcs[i % LCS]) ? 1U : 0U;
+	});
+
+	after = nsPerCall(COUNT, [&](unsigned int i) {
+		g_sink += CRS129::check(lcs[i % LCS]) ? 1U : 0U;
+	});
+
+	report("RS(12,9) check", before, after);
+
+	return true;
+}
+
+// The CRCs at the lengths the NXDN channels protect with them
+static bool benchNXDNCRC()
+{
+	const unsigned int COUNT = 1000000U;
+
+	unsigned char data[32U];
+	::srand(1U);
+	for (unsigned int i = 0U; i < 32U; i++)
+		data[i] = ::rand() & 0xFFU;
+
+	// The SACCH, the FACCH1 and the UDCH
+	double before = nsPerCall(COUNT, [&](unsigned int i) {
+		data[0U] = i;
+		CRefNXDNCRC::encodeCRC6(data, 26U);
+		g_sink += data[3U];
+	});
+
+	double after = nsPerCall(COUNT, [&](unsigned int i) {
+		data[0U] = i;
+		CNXDNCRC::encodeCRC6(data, 26U);
+		g_sink += data[3U];
+	});
+
+	report("NXDN CRC6 on 26 bits", before, after);
+
+	before = nsPerCall(COUNT, [&](unsigned int i) {
+		data[0U] = i;
+		CRefNXDNCRC::encodeCRC12(data, 80U);
+		g_sink += data[10U];
+	});
+
+	after = nsPerCall(COUNT, [&](unsigned int i) {
+		data[0U] = i;
+		CNXDNCRC::encodeCRC12(data, 80U);
+		g_sink += data[10U];
+	});
+
+	report("NXDN CRC12 on 80 bits", before, after);
+
+	before = nsPerCall(COUNT, [&](unsigned int i) {
+		data[0U] = i;
+		CRefNXDNCRC::encodeCRC15(data, 184U);
+		g_sink += data[23U];
+	});
+
+	after = nsPerCall(COUNT, [&](unsigned int i) {
+		data[0U] = i;
+		CNXDNCRC::encodeCRC15(data, 184U);
+		g_sink += data[23U];
+	});
+
+	report("NXDN CRC15 on 184 bits", before, after);
+
+	return true;
+}
+
+// A FACCH1 trellis of 100 steps decoded and chained back, the after rate in M frames/s
+static bool benchViterbi()
+{
+	const unsigned int COUNT = 100000U;
+	const unsigned int STEPS = 100U;
+
+	uint8_t symbols[STEPS * 2U];
+	::srand(1U);
+	for (unsigned int i = 0U; i < STEPS * 2U; i++)
+		symbols[i] = ::rand() % 3U;
+
+	CRefNXDNConvolution ref;
+	CNXDNConvolution conv;
+	unsigned char out1[13U], out2[13U];
+
+	ref.start();
+	conv.start();
+	for (unsigned int i = 0U; i < STEPS; i++) {
+		ref.decode(symbols[i * 2U + 0U], symbols[i * 2U + 1U]);
+		conv.decode(symbols[i * 2U + 0U], symbols[i * 2U + 1U]);
+	}
+	ref.chainback(out1, STEPS - 4U);
+	conv.chainback(out2, STEPS - 4U);
+
+	if (::memcmp(out1, out2, 12U) != 0) {
+		::fprintf(stderr, "Viterbi: the %s kernel differs from the reference\n", CNXDNConvolution::getKernel());
+		return false;
+	}
+
+	double before = nsPerCall(COUNT, [&](unsigned int i) {
+		ref.start();
+		for (unsigned int n = 0U; n < STEPS; n++)
+			ref.decode(symbols[n * 2U + 0U] ^ (i & 1U), symbols[n * 2U + 1U]);
+		ref.chainback(out1, STEPS - 4U);
+		g_sink += out1[0U];
+	});
+
+	double after = nsPerCall(COUNT, [&](unsigned int i) {
+		conv.start();
+		for (unsigned int n = 0U; n < STEPS; n++)
+			conv.decode(symbols[n * 2U + 0U] ^ (i & 1U), symbols[n * 2U + 1U]);
+		conv.chainback(out2, STEPS - 4U);
+		g_sink += out2[0U];
+	});
+
+	std::string name = std::string("Viterbi FACCH1 frame, ") + CNXDNConvolution::getKernel();
+	report(name.c_str(), before, after);
+
+	return true;
+}
+
+// The bits corrected the way CModeConv counted them before the batch calls
+static unsigned int countBits(unsigned int v)
+{
+	unsigned int count = 0U;
+
+	while (v != 0U) {
+		v &= v - 1U;
+		count++;
+	}
+
+	return count;
+}
+
+// Golay (24,12) decoding a word at a time, corrected bits counted by encoding
+// the data again, against the batch call that counts them over the same
+// received words, per code word, the after rate in M code words/s
+static bool benchGolay()
+{
+	const unsigned int COUNT = 20000U;
+	const unsigned int BATCH = 64U;
+
+	unsigned int codes[BATCH], data[BATCH];
+	::srand(1U);
+	for (unsigned int i = 0U; i < BATCH; i++) {
+		// Up to three bit errors in a random code word
+		codes[i] = CGolay24128::encode24128(::rand() & 0xFFFU);
+		for (unsigned int n = ::rand() % 4U; n > 0U; n--)
+			codes[i] ^= 1U << (::rand() % 24U);
+	}
+
+	unsigned int errors = CGolay24128::decode24128(codes, data, BATCH);
+	for (unsigned int i = 0U; i < BATCH; i++) {
+		unsigned int single = CGolay24128::decode24128(codes[i]);
+		errors -= countBits(CGolay24128::encode24128(single) ^ codes[i]);
+
+		if (data[i] != single) {
+			::fprintf(stderr, "Golay: the batch decoder differs from the single word one\n");
+			return false;
+		}
+	}
+
+	if (errors != 0U) {
+		::fprintf(stderr, "Golay: the batch decoder miscounts the corrected bits\n");
+		return false;
+	}
+
+	double before = nsPerCall(COUNT, [&](unsigned int i) {
+		codes[i % BATCH] ^= i & 1U;
+		unsigned int errors = 0U;
+		for (unsigned int n = 0U; n < BATCH; n++) {
+			data[n] = CGolay24128::decode24128(codes[n]);
+			errors += countBits(CGolay24128::encode24128(data[n]) ^ codes[n]);
+		}
+		g_sink += errors + data[i % BATCH];
+	}) / BATCH;
+
+	double after = nsPerCall(COUNT, [&](unsigned int i) {
+		codes[i % BATCH] ^= i & 1U;
+		g_sink += CGolay24128::decode24128(codes, data, BATCH);
+		g_sink += data[i % BATCH];
+	}) / BATCH;
+
+	report("Golay (24,12) decode, batches of 64", before, after);
+
+	before = nsPerCall(COUNT, [&](unsigned int i) {
+		data[i % BATCH] = i & 0xFFFU;
+		for (unsigned int n = 0U; n < BATCH; n++)
+			codes[n] = CGolay24128::encode24128(data[n]);
+		g_sink += codes[i % BATCH];
+	}) / BATCH;
+
+	after = nsPerCall(COUNT, [&](unsigned int i) {
+		data[i % BATCH] = i & 0xFFFU;
+		CGolay24128::encode24128(data, codes, BATCH);
+		g_sink += codes[i % BATCH];
+	}) / BATCH;
+
+	report("Golay (24,12) encode, batches of 64", before, after);
+
+	return true;
+}
+
+// The AMBE frames of a call through CModeConv, queue included, against the
+// bit at a time interleave alone, per AMBE frame, the after rate in M frames/s
+static bool benchModeConv()
+{
+	const unsigned int COUNT  = 100000U;
+	const unsigned int FRAMES = 256U;
+
+	unsigned char frames[FRAMES][33U];
+	::srand(1U);
+	for (unsigned int i = 0U; i < FRAMES; i++) {
+		for (unsigned int n = 0U; n < 33U; n++)
+			frames[i][n] = ::rand() & 0xFFU;
+	}
+
+	CModeConv conv;
+
+	// An NXDN frame in, its four AMBE frames out as DMR bursts, the reference
+	// interleaving the same four fields
+	unsigned char ambe[36U];
+	unsigned char nxdn[33U];
+	unsigned char burst[33U];
+	::memset(burst, 0x00U, 33U);
+
+	conv.putNXDN(frames[0U]);
+	conv.putNXDN(frames[1U]);
+	conv.putNXDN(frames[2U]);
+	for (unsigned int n = 0U; n < 4U; n++) {
+		conv.getDMR(burst);
+
+		// The first AMBE frame of each burst, frame k of the twelve
+		unsigned int k = n * 3U;
+		const unsigned char* data = frames[k / 4U] + 5U + ((k % 4U) / 2U) * 14U;
+		CRefModeConv::encode(data, ambe, (k % 2U) * 49U);
+		if (::memcmp(burst, ambe, 9U) != 0) {
+			::printf("AMBE frame %u differs from the reference\n", k);
+			return false;
+		}
+	}
+
+	double before = nsPerCall(COUNT, [&](unsigned int i) {
+		const unsigned char* data = frames[i % FRAMES] + 5U;
+		CRefModeConv::encode(data, ambe + 0U, 0U);
+		CRefModeConv::encode(data, ambe + 9U, 49U);
+		CRefModeConv::encode(data + 14U, ambe + 18U, 0U);
+		CRefModeConv::encode(data + 14U, ambe + 27U, 49U);
+		g_sink += ambe[i % 36U];
+	}) / 4U;
+
+	double after = nsPerCall(COUNT, [&](unsigned int i) {
+		conv.putNXDN(frames[i % FRAMES]);
+		while (conv.getDMR(burst) == TAG_DATA)
+			g_sink += burst[i % 33U];
+	}) / 4U;
+
+	report("AMBE encode, NXDN to DMR", before, after);
+
+	// A DMR burst in, its three AMBE frames out in NXDN frames
+	before = nsPerCall(COUNT, [&](unsigned int i) {
+		const unsigned char* data = frames[i % FRAMES];
+		g_sink += CRefModeConv::decode(data + 0U, nxdn + 5U, 0U);
+		g_sink += CRefModeConv::decode(data + 9U, nxdn + 5U, 49U);
+		g_sink += CRefModeConv::decode(data + 24U, nxdn + 19U, 0U);
+		g_sink += nxdn[5U + i % 28U];
+	}) / 3U;
+
+	after = nsPerCall(COUNT, [&](unsigned int i) {
+		conv.putDMR(frames[i % FRAMES]);
+		while (conv.getNXDN(nxdn) == TAG_DATA)
+			g_sink += nxdn[5U + i % 28U];
+	}) / 3U;
+
+	report("AMBE decode, DMR to NXDN", before, after);
+
+	return true;
+}
+
+// Bytes added to and taken back out of a ring buffer in chunks, a DMR frame
+// and a single byte at a time, per byte, the after rate in M bytes/s
+static bool benchRingBuffer()
+{
+	const unsigned int COUNT  = 1000000U;
+	const unsigned int LENGTH = 4096U;
+	static const unsigned int CHUNKS[] = {33U, 1U};
+
+	CRefRingBuffer<unsigned char> ref(LENGTH, "Reference");
+	CRingBuffer<unsigned char> buffer(LENGTH, "Benchmark");
+
+	unsigned char in[33U], out1[33U], out2[33U];
+	::srand(1U);
+	for (unsigned int i = 0U; i < 33U; i++)
+		in[i] = ::rand() & 0xFFU;
+
+	// Enough chunks to wrap both buffers many times over
+	for (unsigned int i = 0U; i < 1000U; i++) {
+		in[0U] = i;
+		ref.addData(in, 33U);
+		buffer.addData(in, 33U);
+		ref.getData(out1, 33U);
+		buffer.getData(out2, 33U);
+
+		if (::memcmp(out1, in, 33U) != 0 || ::memcmp(out2, in, 33U) != 0) {
+			::printf("Ring buffer chunk %u differs from the data added\n", i);
+			return false;
+		}
+	}
+
+	for (unsigned int chunk : CHUNKS) {
+		double before = nsPerCall(COUNT, [&](unsigned int i) {
+			in[0U] = i;
+			ref.addData(in, chunk);
+			ref.getData(out1, chunk);
+			g_sink += out1[0U];
+		}) / chunk;
+
+		double after = nsPerCall(COUNT, [&](unsigned int i) {
+			in[0U] = i;
+			buffer.addData(in, chunk);
+			buffer.getData(out2, chunk);
+			g_sink += out2[0U];
+		}) / chunk;
+
+		std::string name = "Ring buffer add and get, " + std::to_string(chunk) + " byte chunks";
+		report(name.c_str(), before, after);
+	}
+
+	return true;
+}
+
+// A lookup file parsed as CDMRLookup or CNXDNLookup parses it into both
+// tables, the reference one only given the Ids the new one accepts
+static bool loadIds(const char* filename, const char* separators, CIdTable& table, CRefIdTable& ref)
+{
+	FILE* fp = ::fopen(filename, "rt");
+	if (fp == NULL)
+		return false;
+
+	char buffer[100U];
+	while (::fgets(buffer, 100U, fp) != NULL) {
+		if (buffer[0U] == '#')
+			continue;
+
+		char* p1 = ::strtok(buffer, separators);
+		char* p2 = ::strtok(NULL, separators);
+
+		if (p1 != NULL && p2 != NULL) {
+			unsigned int id = (unsigned int)::atoi(p1);
+			if (id == 0U)
+				continue;
+
+			for (char* p = p2; *p != 0x00U; p++)
+				*p = ::toupper(*p);
+
+			if (table.add(id, p2))
+				ref.add(id, p2);
+		}
+	}
+
+	::fclose(fp);
+
+	table.sort();
+
+	return true;
+}
+
+// The latency of each lookup of the shipped Id files in the sorted tables
+// against the hash maps they replaced, hits and misses in a scattered order
+static bool benchIdTable(const char* name, const char* filename, const char* separators)
+{
+	const unsigned int COUNT = 1000000U;
+
+	CIdTable table;
+	CRefIdTable ref;
+	if (!loadIds(filename, separators, table, ref)) {
+		::printf("%-40s skipped, no %s\n", name, filename);
+		return true;
+	}
+
+	// Every Id the file holds, and the callsigns the new table gives them
+	std::vector<unsigned int> ids;
+	std::vector<std::string> callsigns;
+	for (unsigned int id = 1U; id < 0x1000000U; id++) {
+		const char* found = table.findCS(id);
+
+		std::string callsign;
+		if (ref.findCS(id, callsign) != (found != NULL) || (found != NULL && callsign != found)) {
+			::fprintf(stderr, "%s: the tables differ for Id %u\n", name, id);
+			return false;
+		}
+
+		if (found != NULL) {
+			ids.push_back(id);
+			callsigns.push_back(found);
+		}
+	}
+
+	for (const std::string& callsign : callsigns) {
+		if (table.findID(callsign.c_str()) != ref.findID(callsign)) {
+			::fprintf(stderr, "%s: the tables differ for callsign %s\n", name, callsign.c_str());
+			return false;
+		}
+	}
+
+	unsigned int n = (unsigned int)ids.size();
+
+	// A prime stride visits the entries out of order
+	double before = nsPerCall(COUNT, [&](unsigned int i) {
+		std::string callsign;
+		ref.findCS(ids[(i * 7919U) % n], callsign);
+		g_sink += callsign[0U];
+	});
+
+	double after = nsPerCall(COUNT, [&](unsigned int i) {
+		g_sink += table.findCS(ids[(i * 7919U) % n])[0U];
+	});
+
+	report((std::string(name) + " findCS").c_str(), before, after);
+
+	before = nsPerCall(COUNT, [&](unsigned int i) {
+		g_sink += ref.exists(ids[(i * 7919U) % n] + 0x1000000U) ? 1U : 0U;
+	});
+
+	after = nsPerCall(COUNT, [&](unsigned int i) {
+		g_sink += table.exists(ids[(i * 7919U) % n] + 0x1000000U) ? 1U : 0U;
+	});
+
+	report((std::string(name) + " exists, miss").c_str(), before, after);
+
+	before = nsPerCall(COUNT, [&](unsigned int i) {
+		g_sink += ref.findID(callsigns[(i * 7919U) % n]);
+	});
+
+	after = nsPerCall(COUNT, [&](unsigned int i) {
+		g_sink += table.findID(callsigns[(i * 7919U) % n].c_str());
+	});
+
+	report((std::string(name) + " findID").c_str(), before, after);
+
+	::printf("%-40s %u Ids, %.1f bytes per Id\n", name, n, double(table.memory()) / double(n));
+
+	return true;
+}
+
+static bool benchIdTables()
+{
+	bool ok = benchIdTable("DMR Ids", "DMRIds.dat", " \t\r\n");
+
+	return benchIdTable("NXDN Ids", "NXDN.csv", ",\t\r\n") && ok;
+}
+
+struct CBenchmark {
+	const char* m_name;
+	bool (*m_run)();
+};
+
+static const CBenchmark BENCHMARKS[] = {
+	{"nxdn-template", benchNXDNTemplate},
+	{"bptc",          benchBPTC},
+	{"hamming",       benchHamming},
+	{"rs129",         benchRS129},
+	{"golay",         benchGolay},
+	{"nxdn-crc",      benchNXDNCRC},
+	{"viterbi",       benchViterbi},
+	{"modeconv",      benchModeConv},
+	{"ringbuffer",    benchRingBuffer},
+	{"idtable",       benchIdTables}
+};
+
+int main(int argc, char** argv)
+{
+	std::string only = argc > 1 ? argv[1] : "";
+
+	::printf("%-40s %12s %12s %8s %13s\n", "", "before", "after", "speedup", "after rate");
+
+	bool ok = true;
+	for (const CBenchmark& benchmark : BENCHMARKS) {
+		if (only.empty() || only == benchmark.m_name)
+			ok = benchmark.m_run() && ok;
+	}
+
+	return ok ? 0 : 1;
+}
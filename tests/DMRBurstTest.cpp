@@ -0,0 +1,128 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "DMRDefines.h"
+#include "Golay2087.h"
+#include "DMRBurst.h"
+#include "QR1676.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Every EMB, slot type and sync written by CDMRBurst against the byte wise
+// code that wrote them before the burst words, on a number of random bursts
+
+const unsigned int BURSTS = 64U;
+
+static void refEMB(unsigned char* data, unsigned char colorCode, bool pi, unsigned char lcss)
+{
+	unsigned char emb[2U];
+	emb[0U]  = (colorCode << 4) & 0xF0U;
+	emb[0U] |= pi ? 0x08U : 0x00U;
+	emb[0U] |= (lcss << 1) & 0x06U;
+	emb[1U]  = 0x00U;
+
+	CQR1676::encode(emb);
+
+	data[13U] = (data[13U] & 0xF0U) | ((emb[0U] >> 4U) & 0x0FU);
+	data[14U] = (data[14U] & 0x0FU) | ((emb[0U] << 4U) & 0xF0U);
+	data[18U] = (data[18U] & 0xF0U) | ((emb[1U] >> 4U) & 0x0FU);
+	data[19U] = (data[19U] & 0x0FU) | ((emb[1U] << 4U) & 0xF0U);
+}
+
+static void refSlotType(unsigned char* data, unsigned char colorCode, unsigned char dataType)
+{
+	unsigned char slotType[3U];
+	slotType[0U]  = (colorCode << 4) & 0xF0U;
+	slotType[0U] |= (dataType  << 0) & 0x0FU;
+	slotType[1U]  = 0x00U;
+	slotType[2U]  = 0x00U;
+
+	CGolay2087::encode(slotType);
+
+	data[12U] = (data[12U] & 0xC0U) | ((slotType[0U] >> 2) & 0x3FU);
+	data[13U] = (data[13U] & 0x0FU) | ((slotType[0U] << 6) & 0xC0U) | ((slotType[1U] >> 2) & 0x30U);
+	data[19U] = (data[19U] & 0xF0U) | ((slotType[1U] >> 2) & 0x0FU);
+	data[20U] = (data[20U] & 0x03U) | ((slotType[1U] << 6) & 0xC0U) | ((slotType[2U] >> 2) & 0x3CU);
+}
+
+static void refSync(unsigned char* data, const unsigned char* sync)
+{
+	for (unsigned int i = 0U; i < 7U; i++)
+		data[i + 13U] = (data[i + 13U] & ~SYNC_MASK[i]) | sync[i];
+}
+
+static unsigned int compare(const char* name, unsigned int count, void (*burst)(unsigned char*, unsigned int), void (*ref)(unsigned char*, unsigned int))
+{
+	unsigned int mismatches = 0U;
+
+	for (unsigned int value = 0U; value < count; value++) {
+		for (unsigned int n = 0U; n < BURSTS; n++) {
+			unsigned char data1[33U], data2[33U];
+			for (unsigned int i = 0U; i < 33U; i++)
+				data1[i] = data2[i] = ::rand() & 0xFFU;
+
+			burst(data1, value);
+			ref(data2, value);
+
+			if (::memcmp(data1, data2, 33U) != 0)
+				mismatches++;
+		}
+	}
+
+	::printf("%s: %u values, %u mismatches\n", name, count, mismatches);
+
+	return mismatches;
+}
+
+int main()
+{
+	::srand(1U);
+
+	unsigned int failures = 0U;
+
+	// Colour code, PI and LCSS
+	failures += compare("EMB", 128U,
+		[](unsigned char* data, unsigned int value) { CDMRBurst::addEMB(data, value >> 3, (value & 0x04U) != 0U, value & 0x03U); },
+		[](unsigned char* data, unsigned int value) { refEMB(data, value >> 3, (value & 0x04U) != 0U, value & 0x03U); });
+
+	// Colour code and data type
+	failures += compare("Slot type", 256U,
+		[](unsigned char* data, unsigned int value) { CDMRBurst::addSlotType(data, value >> 4, value & 0x0FU); },
+		[](unsigned char* data, unsigned int value) { refSlotType(data, value >> 4, value & 0x0FU); });
+
+	// Colour code, data type and duplex
+	failures += compare("Data sync and slot type", 512U,
+		[](unsigned char* data, unsigned int value) { CDMRBurst::addDataSync(data, (value & 0x01U) != 0U, value >> 5, (value >> 1) & 0x0FU); },
+		[](unsigned char* data, unsigned int value) {
+			refSync(data, (value & 0x01U) != 0U ? BS_SOURCED_DATA_SYNC : MS_SOURCED_DATA_SYNC);
+			refSlotType(data, value >> 5, (value >> 1) & 0x0FU);
+		});
+
+	failures += compare("Audio sync", 2U,
+		[](unsigned char* data, unsigned int value) { CDMRBurst::addAudioSync(data, value != 0U); },
+		[](unsigned char* data, unsigned int value) { refSync(data, value != 0U ? BS_SOURCED_AUDIO_SYNC : MS_SOURCED_AUDIO_SYNC); });
+
+	failures += compare("Data sync", 2U,
+		[](unsigned char* data, unsigned int value) { CDMRBurst::addDataSync(data, value != 0U); },
+		[](unsigned char* data, unsigned int value) { refSync(data, value != 0U ? BS_SOURCED_DATA_SYNC : MS_SOURCED_DATA_SYNC); });
+
+	return failures == 0U ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "Golay24128.h"
+
+#include <cstdio>
+
+// Every 24 and 23 bit received word through the batch decoders against the
+// single word ones, which must give the same data, and an error count equal
+// to the bits between the received word and the code word of that data
+
+const unsigned int BATCH = 256U;
+
+static unsigned int countBits(unsigned int v)
+{
+	return (unsigned int)__builtin_popcount(v);
+}
+
+int main()
+{
+	unsigned int failures = 0U;
+
+	unsigned int mismatches = 0U;
+	unsigned int data[BATCH], codes[BATCH], single[BATCH];
+
+	for (unsigned int first = 0U; first < 4096U; first += BATCH) {
+		for (unsigned int i = 0U; i < BATCH; i++)
+			data[i] = first + i;
+
+		CGolay24128::encode23127(data, codes, BATCH);
+		for (unsigned int i = 0U; i < BATCH; i++) {
+			if (codes[i] != CGolay24128::encode23127(data[i]))
+				mismatches++;
+		}
+
+		CGolay24128::encode24128(data, codes, BATCH);
+		for (unsigned int i = 0U; i < BATCH; i++) {
+			if (codes[i] != CGolay24128::encode24128(data[i]))
+				mismatches++;
+		}
+	}
+
+	::printf("Golay (24,12) and (23,12) encode: 4096 words, %u mismatches\n", mismatches);
+	failures += mismatches;
+
+	mismatches = 0U;
+	for (unsigned int first = 0U; first < (1U << 24); first += BATCH) {
+		for (unsigned int i = 0U; i < BATCH; i++)
+			codes[i] = first + i;
+
+		unsigned int errors = CGolay24128::decode24128(codes, data, BATCH);
+
+		unsigned int expected = 0U;
+		for (unsigned int i = 0U; i < BATCH; i++) {
+			single[i] = CGolay24128::decode24128(codes[i]);
+			if (data[i] != single[i])
+				mismatches++;
+
+			expected += countBits(CGolay24128::encode24128(single[i]) ^ codes[i]);
+		}
+
+		if (errors != expected)
+			mismatches++;
+	}
+
+	::printf("Golay (24,12) decode: %u words, %u mismatches\n", 1U << 24, mismatches);
+	failures += mismatches;
+
+	mismatches = 0U;
+	for (unsigned int first = 0U; first < (1U << 23); first += BATCH) {
+		for (unsigned int i = 0U; i < BATCH; i++)
+			codes[i] = first + i;
+
+		unsigned int errors = CGolay24128::decode23127(codes, data, BATCH);
+
+		unsigned int expected = 0U;
+		for (unsigned int i = 0U; i < BATCH; i++) {
+			single[i] = CGolay24128::decode23127(codes[i]);
+			if (data[i] != single[i])
+				mismatches++;
+
+			expected += countBits((CGolay24128::encode23127(single[i]) >> 1) ^ codes[i]);
+		}
+
+		if (errors != expected)
+			mismatches++;
+	}
+
+	::printf("Golay (23,12) decode: %u words, %u mismatches\n", 1U << 23, mismatches);
+	failures += mismatches;
+
+	return failures == 0U ? 0 : 1;
+}
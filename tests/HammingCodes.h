@@ -0,0 +1,66 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(HAMMINGCODES_H)
+#define	HAMMINGCODES_H
+
+#include "Hamming.h"
+
+// Each Hamming code of CHamming with its bool array and packed word calls
+struct CHammingCode {
+	const char*  m_name;
+	unsigned int m_length;
+	void         (*m_encodeBool)(bool* d);
+	bool         (*m_decodeBool)(bool* d);
+	unsigned int (*m_encodeWord)(unsigned int d);
+	bool         (*m_decodeWord)(unsigned int& d);
+};
+
+static const CHammingCode HAMMING_CODES[] = {
+	{"Hamming (15,11,3) #1", 15U, [](bool* d) { CHamming::encode15113_1(d); }, [](bool* d) { return CHamming::decode15113_1(d); },
+		[](unsigned int d) { return CHamming::encode15113_1(d); }, [](unsigned int& d) { return CHamming::decode15113_1(d); }},
+	{"Hamming (15,11,3) #2", 15U, [](bool* d) { CHamming::encode15113_2(d); }, [](bool* d) { return CHamming::decode15113_2(d); },
+		[](unsigned int d) { return CHamming::encode15113_2(d); }, [](unsigned int& d) { return CHamming::decode15113_2(d); }},
+	{"Hamming (13,9,3)",     13U, [](bool* d) { CHamming::encode1393(d); },    [](bool* d) { return CHamming::decode1393(d); },
+		[](unsigned int d) { return CHamming::encode1393(d); },    [](unsigned int& d) { return CHamming::decode1393(d); }},
+	{"Hamming (10,6,3)",     10U, [](bool* d) { CHamming::encode1063(d); },    [](bool* d) { return CHamming::decode1063(d); },
+		[](unsigned int d) { return CHamming::encode1063(d); },    [](unsigned int& d) { return CHamming::decode1063(d); }},
+	{"Hamming (16,11,4)",    16U, [](bool* d) { CHamming::encode16114(d); },   [](bool* d) { return CHamming::decode16114(d); },
+		[](unsigned int d) { return CHamming::encode16114(d); },   [](unsigned int& d) { return CHamming::decode16114(d); }},
+	{"Hamming (17,12,3)",    17U, [](bool* d) { CHamming::encode17123(d); },   [](bool* d) { return CHamming::decode17123(d); },
+		[](unsigned int d) { return CHamming::encode17123(d); },   [](unsigned int& d) { return CHamming::decode17123(d); }}
+};
+
+// The word is MSB first, so d[0] is its bit length - 1
+inline void wordToBools(unsigned int word, bool* d, unsigned int length)
+{
+	for (unsigned int n = 0U; n < length; n++)
+		d[n] = ((word >> (length - 1U - n)) & 0x01U) != 0U;
+}
+
+inline unsigned int boolsToWord(const bool* d, unsigned int length)
+{
+	unsigned int word = 0U;
+	for (unsigned int n = 0U; n < length; n++)
+		word = (word << 1) | (d[n] ? 0x01U : 0x00U);
+
+	return word;
+}
+
+#endif
@@ -0,0 +1,58 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "HammingCodes.h"
+
+#include <cstdio>
+
+// Every input word of every code through the packed word calls and the bool
+// array calls, which must give the same codeword, correction and result
+int main()
+{
+	unsigned int failures = 0U;
+
+	for (const CHammingCode& code : HAMMING_CODES) {
+		unsigned int mismatches = 0U;
+		unsigned int words = 1U << code.m_length;
+
+		for (unsigned int word = 0U; word < words; word++) {
+			bool d[17U];
+
+			wordToBools(word, d, code.m_length);
+			code.m_encodeBool(d);
+			if (boolsToWord(d, code.m_length) != code.m_encodeWord(word))
+				mismatches++;
+
+			wordToBools(word, d, code.m_length);
+			bool boolResult = code.m_decodeBool(d);
+
+			unsigned int decoded = word;
+			bool wordResult = code.m_decodeWord(decoded);
+
+			if (boolResult != wordResult || boolsToWord(d, code.m_length) != decoded)
+				mismatches++;
+		}
+
+		::printf("%s: %u words, %u mismatches\n", code.m_name, words, mismatches);
+
+		failures += mismatches;
+	}
+
+	return failures == 0U ? 0 : 1;
+}
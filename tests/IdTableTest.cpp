@@ -0,0 +1,110 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "IdTable.h"
+#include "Thread.h"
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+
+// An index must be compiled again whenever its lookup file changes, even when
+// rewritten at the same size within the same second, emptied, or changed while
+// it was being parsed, and must stay usable on its own when the lookup file
+// is gone
+
+const char SOURCE[] = "tests/IdTableTest.txt";
+const char INDEX[]  = "tests/IdTableTest.idx";
+
+static bool writeSource(const char* text)
+{
+	FILE* fp = ::fopen(SOURCE, "wt");
+	if (fp == NULL)
+		return false;
+
+	::fputs(text, fp);
+
+	return ::fclose(fp) == 0;
+}
+
+static bool compile(const char* callsign, uint64_t size, int64_t time)
+{
+	CIdTable table;
+	if (callsign != NULL)
+		table.add(1234567U, callsign);
+	table.sort();
+
+	return table.save(INDEX, size, time);
+}
+
+// The source as it is now
+static bool compile(const char* callsign)
+{
+	uint64_t size;
+	int64_t  time;
+	CIdTable::getSource(SOURCE, size, time);
+
+	return compile(callsign, size, time);
+}
+
+static bool check(const char* name, bool result, bool expected)
+{
+	::printf("%s: %s\n", name, result == expected ? "ok" : "FAILED");
+
+	return result == expected;
+}
+
+int main()
+{
+	bool ok = true;
+
+	CIdTable table;
+
+	ok = writeSource("1234567 AB1CDE\n") && compile("AB1CDE") && ok;
+	ok = check("Unchanged source", table.map(INDEX, SOURCE), true) && ok;
+
+	// The same size well within the second, longer than the coarsest clock ticks file times keep
+	CThread::sleep(20U);
+	ok = writeSource("1234567 XY9ZZZ\n") && ok;
+	ok = check("Rewritten at the same size", table.map(INDEX, SOURCE), false) && ok;
+
+	// An empty source exists, it must not be taken for a missing one
+	ok = compile("XY9ZZZ") && writeSource("") && ok;
+	ok = check("Emptied source", table.map(INDEX, SOURCE), false) && ok;
+
+	// Rewritten after the stat that goes into the index, as if while it was being parsed
+	uint64_t size;
+	int64_t  time;
+	ok = writeSource("1234567 AB1CDE\n") && CIdTable::getSource(SOURCE, size, time) && ok;
+	CThread::sleep(20U);
+	ok = writeSource("1234567 XY9ZZZ\n") && compile("AB1CDE", size, time) && ok;
+	ok = check("Changed while parsed", table.map(INDEX, SOURCE), false) && ok;
+
+	ok = writeSource("") && compile(NULL) && ok;
+	ok = check("Empty source compiled", table.map(INDEX, SOURCE) && table.size() == 0U, true) && ok;
+
+	ok = writeSource("1234567 AB1CDE\n") && compile("AB1CDE") && ok;
+	::remove(SOURCE);
+	ok = check("Missing source", table.map(INDEX, SOURCE) && table.size() == 1U, true) && ok;
+
+	table.map("", "");
+	::remove(INDEX);
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "RefModeConv.h"
+#include "ModeConv.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// Random frames through CModeConv in both directions against the bit at a
+// time interleave, with the fields at both offsets of each NXDN half frame.
+// "make check" runs it again with the CPU extensions masked off, so both the
+// BMI2 and the table kernels are covered
+
+const unsigned int RUNS = 20000U;
+
+static void randomFill(unsigned char* data, unsigned int length)
+{
+	for (unsigned int i = 0U; i < length; i++)
+		data[i] = ::rand() & 0xFFU;
+}
+
+// The three AMBE frames of a DMR voice burst, either side of the sync
+static void splitBurst(const unsigned char* burst, unsigned char* ambe)
+{
+	::memcpy(ambe + 0U, burst + 0U, 9U);
+
+	::memcpy(ambe + 9U, burst + 9U, 4U);
+	ambe[13U] = (burst[13U] & 0xF0U) | (burst[19U] & 0x0FU);
+	::memcpy(ambe + 14U, burst + 20U, 4U);
+
+	::memcpy(ambe + 18U, burst + 24U, 9U);
+}
+
+// Three NXDN frames, twelve AMBE frames out, read back as four DMR bursts
+static unsigned int testEncode()
+{
+	unsigned int mismatches = 0U;
+
+	CModeConv conv;
+
+	for (unsigned int run = 0U; run < RUNS; run++) {
+		unsigned char ambe[12U * 9U];
+		for (unsigned int n = 0U; n < 3U; n++) {
+			unsigned char nxdn[33U];
+			randomFill(nxdn, 33U);
+
+			conv.putNXDN(nxdn);
+
+			unsigned char* out = ambe + n * 36U;
+			CRefModeConv::encode(nxdn + 5U,  out + 0U,  0U);
+			CRefModeConv::encode(nxdn + 5U,  out + 9U,  49U);
+			CRefModeConv::encode(nxdn + 19U, out + 18U, 0U);
+			CRefModeConv::encode(nxdn + 19U, out + 27U, 49U);
+		}
+
+		for (unsigned int n = 0U; n < 4U; n++) {
+			unsigned char burst[33U];
+			::memset(burst, 0x00U, 33U);
+
+			unsigned char frames[27U];
+			if (conv.getDMR(burst) != TAG_DATA) {
+				mismatches++;
+				continue;
+			}
+
+			splitBurst(burst, frames);
+			if (::memcmp(frames, ambe + n * 27U, 27U) != 0)
+				mismatches++;
+		}
+	}
+
+	return mismatches;
+}
+
+// Four DMR bursts, twelve AMBE frames out, read back as three NXDN frames
+static unsigned int testDecode()
+{
+	unsigned int mismatches = 0U;
+
+	CModeConv conv;
+
+	for (unsigned int run = 0U; run < RUNS; run++) {
+		conv.putDMRHeader();
+		unsigned char nxdn[33U];
+		conv.getNXDN(nxdn);
+
+		unsigned char ambe[12U * 9U];
+		for (unsigned int n = 0U; n < 4U; n++) {
+			unsigned char burst[33U];
+			randomFill(burst, 33U);
+
+			conv.putDMR(burst);
+			splitBurst(burst, ambe + n * 27U);
+		}
+
+		unsigned int errors = 0U;
+
+		for (unsigned int n = 0U; n < 3U; n++) {
+			unsigned char nxdn1[33U], nxdn2[33U];
+			randomFill(nxdn1, 33U);
+			::memcpy(nxdn2, nxdn1, 33U);
+
+			if (conv.getNXDN(nxdn1) != TAG_DATA) {
+				mismatches++;
+				continue;
+			}
+
+			const unsigned char* in = ambe + n * 36U;
+			::memset(nxdn2 + 5U, 0x00U, 28U);
+			errors += CRefModeConv::decode(in + 0U,  nxdn2 + 5U,  0U);
+			errors += CRefModeConv::decode(in + 9U,  nxdn2 + 5U,  49U);
+			errors += CRefModeConv::decode(in + 18U, nxdn2 + 19U, 0U);
+			errors += CRefModeConv::decode(in + 27U, nxdn2 + 19U, 49U);
+
+			if (::memcmp(nxdn1, nxdn2, 33U) != 0)
+				mismatches++;
+		}
+
+		if (conv.getDMRErrors() != errors || conv.getDMRBits() != 12U * 47U)
+			mismatches++;
+	}
+
+	return mismatches;
+}
+
+int main()
+{
+	::srand(1U);
+
+	unsigned int failures = 0U;
+
+	unsigned int mismatches = testEncode();
+	::printf("AMBE encode, %s kernel: %u runs, %u mismatches\n", CModeConv::getKernel(), RUNS, mismatches);
+	failures += mismatches;
+
+	mismatches = testDecode();
+	::printf("AMBE decode, %s kernel: %u runs, %u mismatches\n", CModeConv::getKernel(), RUNS, mismatches);
+	failures += mismatches;
+
+	return failures == 0U ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "RefNXDNCRC.h"
+#include "NXDNCRC.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// The byte table CRCs against the bit at a time ones they replaced, on random
+// data of every length the frames use and more, with and without bit errors
+
+const unsigned int RUNS = 20000U;
+
+struct CCRCCode {
+	const char*  m_name;
+	unsigned int m_width;
+	void (*m_encode)(unsigned char* in, unsigned int length);
+	bool (*m_check)(const unsigned char* in, unsigned int length);
+	void (*m_refEncode)(unsigned char* in, unsigned int length);
+	bool (*m_refCheck)(const unsigned char* in, unsigned int length);
+};
+
+static const CCRCCode CRC_CODES[] = {
+	{"CRC6",  6U,  CNXDNCRC::encodeCRC6,  CNXDNCRC::checkCRC6,  CRefNXDNCRC::encodeCRC6,  CRefNXDNCRC::checkCRC6},
+	{"CRC12", 12U, CNXDNCRC::encodeCRC12, CNXDNCRC::checkCRC12, CRefNXDNCRC::encodeCRC12, CRefNXDNCRC::checkCRC12},
+	{"CRC15", 15U, CNXDNCRC::encodeCRC15, CNXDNCRC::checkCRC15, CRefNXDNCRC::encodeCRC15, CRefNXDNCRC::checkCRC15}
+};
+
+int main()
+{
+	::srand(1U);
+
+	unsigned int failures = 0U;
+
+	for (const CCRCCode& code : CRC_CODES) {
+		unsigned int mismatches = 0U;
+
+		for (unsigned int run = 0U; run < RUNS; run++) {
+			unsigned int length = 1U + ::rand() % 256U;
+
+			unsigned char data1[40U], data2[40U];
+			for (unsigned int i = 0U; i < 40U; i++)
+				data1[i] = data2[i] = ::rand() & 0xFFU;
+
+			// The CRC goes in after the data, the bits around it must be left alone
+			code.m_encode(data1, length);
+			code.m_refEncode(data2, length);
+			if (::memcmp(data1, data2, 40U) != 0)
+				mismatches++;
+
+			if (code.m_check(data1, length) != code.m_refCheck(data1, length) || !code.m_check(data1, length))
+				mismatches++;
+
+			// A bit error in the data or the CRC
+			unsigned int bit = ::rand() % (length + code.m_width);
+			data1[bit >> 3] ^= 0x80U >> (bit & 0x07U);
+			if (code.m_check(data1, length) != code.m_refCheck(data1, length))
+				mismatches++;
+
+			// Random data with no valid CRC at all
+			for (unsigned int i = 0U; i < 40U; i++)
+				data1[i] = ::rand() & 0xFFU;
+			if (code.m_check(data1, length) != code.m_refCheck(data1, length))
+				mismatches++;
+		}
+
+		::printf("%s: %u runs, %u mismatches\n", code.m_name, RUNS, mismatches);
+
+		failures += mismatches;
+	}
+
+	return failures == 0U ? 0 : 1;
+}
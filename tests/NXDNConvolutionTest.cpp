@@ -0,0 +1,99 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "RefNXDNConvolution.h"
+#include "NXDNConvolution.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// The Viterbi decoder, with whichever kernel the CPU picked, against the one
+// butterfly at a time decoder it replaced. Random soft symbols exercise the
+// ties, encoded data with symbol errors the corrections.
+
+const unsigned int RUNS = 20000U;
+
+// The trellis lengths of the SACCH, the FACCH1 and the most the decoder holds
+const unsigned int STEPS[] = {40U, 100U, 300U};
+
+int main()
+{
+	::srand(1U);
+
+	unsigned int failures = 0U;
+
+	for (unsigned int steps : STEPS) {
+		unsigned int mismatches = 0U;
+		unsigned int nBits = steps - 4U;
+
+		for (unsigned int run = 0U; run < RUNS; run++) {
+			uint8_t symbols[600U];
+
+			if ((run & 1U) == 0U) {
+				for (unsigned int i = 0U; i < steps * 2U; i++)
+					symbols[i] = ::rand() % 3U;
+			} else {
+				unsigned char data[40U], encoded[80U];
+				for (unsigned int i = 0U; i < 40U; i++)
+					data[i] = ::rand() & 0xFFU;
+
+				CNXDNConvolution conv;
+				conv.encode(data, encoded, steps);
+
+				for (unsigned int i = 0U; i < steps * 2U; i++) {
+					bool b = (encoded[i >> 3] & (0x80U >> (i & 0x07U))) != 0U;
+					symbols[i] = b ? 2U : 0U;
+
+					// About one symbol in eight in error or erased
+					unsigned int error = ::rand() % 16U;
+					if (error == 0U)
+						symbols[i] = 2U - symbols[i];
+					else if (error == 1U)
+						symbols[i] = 1U;
+				}
+			}
+
+			unsigned char out1[40U], out2[40U];
+			::memset(out1, 0x00U, 40U);
+			::memset(out2, 0x00U, 40U);
+
+			CNXDNConvolution conv;
+			conv.start();
+			for (unsigned int i = 0U; i < steps; i++)
+				conv.decode(symbols[i * 2U + 0U], symbols[i * 2U + 1U]);
+			conv.chainback(out1, nBits);
+
+			CRefNXDNConvolution ref;
+			ref.start();
+			for (unsigned int i = 0U; i < steps; i++)
+				ref.decode(symbols[i * 2U + 0U], symbols[i * 2U + 1U]);
+			ref.chainback(out2, nBits);
+
+			if (::memcmp(out1, out2, 40U) != 0)
+				mismatches++;
+		}
+
+		::printf("Viterbi (%s) %u steps: %u runs, %u mismatches\n", CNXDNConvolution::getKernel(), steps, RUNS, mismatches);
+
+		failures += mismatches;
+	}
+
+	return failures == 0U ? 0 : 1;
+}
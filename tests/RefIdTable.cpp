@@ -0,0 +1,67 @@
+/*
+ *   Copyright (C) 2016,2017 by Jonathan Naylor G4KLX
+ *   Copyright (C) 2018 by Andy Uribe CA6JAU
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "RefIdTable.h"
+
+CRefIdTable::CRefIdTable() :
+m_table(),
+m_cstable()
+{
+}
+
+CRefIdTable::~CRefIdTable()
+{
+}
+
+void CRefIdTable::add(unsigned int id, const std::string& callsign)
+{
+	m_table[id] = callsign;
+	m_cstable[callsign] = id;
+}
+
+bool CRefIdTable::findCS(unsigned int id, std::string& callsign) const
+{
+	std::unordered_map<unsigned int, std::string>::const_iterator it = m_table.find(id);
+	if (it == m_table.end())
+		return false;
+
+	callsign = it->second;
+
+	return true;
+}
+
+unsigned int CRefIdTable::findID(const std::string& callsign) const
+{
+	std::unordered_map<std::string, unsigned int>::const_iterator it = m_cstable.find(callsign);
+	if (it == m_cstable.end())
+		return 0U;
+
+	return it->second;
+}
+
+bool CRefIdTable::exists(unsigned int id) const
+{
+	return m_table.count(id) == 1U;
+}
+
+unsigned int CRefIdTable::size() const
+{
+	return (unsigned int)m_table.size();
+}
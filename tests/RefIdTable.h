@@ -0,0 +1,48 @@
+/*
+ *   Copyright (C) 2016,2017 by Jonathan Naylor G4KLX
+ *   Copyright (C) 2018 by Andy Uribe CA6JAU
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#if !defined(REFIDTABLE_H)
+#define	REFIDTABLE_H
+
+#include <string>
+#include <unordered_map>
+
+// The Id to callsign mappings of one load of a lookup file in hash maps as
+// they were before the sorted arrays, kept as the reference for the benchmarks
+class CRefIdTable {
+public:
+	CRefIdTable();
+	~CRefIdTable();
+
+	void add(unsigned int id, const std::string& callsign);
+
+	bool findCS(unsigned int id, std::string& callsign) const;
+	unsigned int findID(const std::string& callsign) const;
+
+	bool exists(unsigned int id) const;
+
+	unsigned int size() const;
+
+private:
+	std::unordered_map<unsigned int, std::string> m_table;
+	std::unordered_map<std::string, unsigned int> m_cstable;
+};
+
+#endif
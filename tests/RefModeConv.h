@@ -0,0 +1,36 @@
+/*
+ *   Copyright (C) 2010,2014,2016,2018 by Jonathan Naylor G4KLX
+ *   Copyright (C) 2018 by Andy Uribe CA6JAU
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(REFMODECONV_H)
+#define	REFMODECONV_H
+
+// The AMBE frame interleave a bit at a time through the A, B and C position
+// tables, as CModeConv did it before the byte tables and the batch Golay
+// calls, with the word at a time Golay correction of the DMR frames, kept as
+// the reference for the tests and benchmarks
+class CRefModeConv
+{
+public:
+	static void encode(const unsigned char* in, unsigned char* out, unsigned int offset);
+
+	// Returns the bits the Golay codes corrected
+	static unsigned int decode(const unsigned char* in, unsigned char* out, unsigned int offset);
+};
+
+#endif
@@ -0,0 +1,32 @@
+/*
+ *   Copyright (C) 2015 by Jonathan Naylor G4KLX
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+#if !defined(REFRS129_H)
+#define	REFRS129_H
+
+// The RS(12,9) code on log and antilog tables as it was before the single
+// feedback table, kept as the reference for the tests and benchmarks
+class CRefRS129
+{
+public:
+	static bool check(const unsigned char* in);
+
+	static void encode(const unsigned char* msg, unsigned int nbytes, unsigned char* parity);
+};
+
+#endif
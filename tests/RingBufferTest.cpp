@@ -0,0 +1,245 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "RingBuffer.h"
+#include "Thread.h"
+#include "Log.h"
+
+#include <cstdio>
+#include <cstdint>
+#include <thread>
+
+// The length rounding, every split of the two memcpy wrap in and out, both
+// kinds of overflow, and a writer thread pushing a counter through an SPSC
+// buffer to a reader that must see every value once and in order
+
+const unsigned int SPSC_VALUES = 4000000U;
+
+static unsigned int testRounding()
+{
+	static const unsigned int LENGTHS[] = {1U, 2U, 3U, 100U, 128U, 129U, 5000U};
+	static const unsigned int ROUNDED[] = {1U, 2U, 4U, 128U, 128U, 256U, 8192U};
+
+	unsigned int mismatches = 0U;
+
+	for (unsigned int i = 0U; i < 7U; i++) {
+		CRingBuffer<unsigned char> buffer(LENGTHS[i], "Rounding");
+
+		if (buffer.freeSpace() != ROUNDED[i] || !buffer.isEmpty())
+			mismatches++;
+
+		// The whole rounded length is usable
+		unsigned char data[8192U];
+		for (unsigned int n = 0U; n < ROUNDED[i]; n++)
+			data[n] = n & 0xFFU;
+
+		if (!buffer.addData(data, ROUNDED[i]) || buffer.freeSpace() != 0U || buffer.dataSize() != ROUNDED[i])
+			mismatches++;
+	}
+
+	return mismatches;
+}
+
+// Every chunk length written and read back from every start position, so the
+// second memcpy copies from nothing up to all but one of the values
+static unsigned int testWrap()
+{
+	const unsigned int LENGTH = 16U;
+
+	unsigned int mismatches = 0U;
+	unsigned int value = 0U;
+
+	for (unsigned int start = 0U; start < LENGTH; start++) {
+		for (unsigned int count = 1U; count <= LENGTH; count++) {
+			CRingBuffer<uint32_t> buffer(LENGTH, "Wrap");
+
+			uint32_t data[LENGTH];
+			for (unsigned int n = 0U; n < start; n++)
+				data[n] = 0xFFFFFFFFU;
+			buffer.addData(data, start);
+			buffer.getData(data, start);
+
+			uint32_t in[LENGTH], peeked[LENGTH], out[LENGTH];
+			for (unsigned int n = 0U; n < count; n++)
+				in[n] = value++;
+
+			if (!buffer.addData(in, count) || buffer.dataSize() != count)
+				mismatches++;
+
+			if (!buffer.peek(peeked, count) || !buffer.getData(out, count) || !buffer.isEmpty())
+				mismatches++;
+
+			for (unsigned int n = 0U; n < count; n++) {
+				if (peeked[n] != in[n] || out[n] != in[n])
+					mismatches++;
+			}
+		}
+	}
+
+	return mismatches;
+}
+
+// Without SPSC an overflow clears the buffer, with it the new data is dropped
+static unsigned int testOverflow(bool spsc)
+{
+	unsigned int mismatches = 0U;
+
+	CRingBuffer<uint32_t> buffer(16U, "Overflow", spsc);
+
+	uint32_t first[10U], second[10U];
+	for (unsigned int n = 0U; n < 10U; n++) {
+		first[n]  = n;
+		second[n] = n + 100U;
+	}
+
+	buffer.addData(first, 10U);
+
+	if (buffer.addData(second, 10U))
+		mismatches++;
+
+	uint32_t out[10U];
+	if (spsc) {
+		if (buffer.dataSize() != 10U || !buffer.getData(out, 10U))
+			mismatches++;
+
+		for (unsigned int n = 0U; n < 10U; n++) {
+			if (out[n] != first[n])
+				mismatches++;
+		}
+	} else {
+		if (!buffer.isEmpty())
+			mismatches++;
+
+		// A cleared buffer takes the data again
+		if (!buffer.addData(second, 10U) || !buffer.getData(out, 10U))
+			mismatches++;
+
+		for (unsigned int n = 0U; n < 10U; n++) {
+			if (out[n] != second[n])
+				mismatches++;
+		}
+	}
+
+	return mismatches;
+}
+
+class CWriter : public CThread {
+public:
+	CWriter(CRingBuffer<uint32_t>& buffer) :
+	CThread(),
+	m_buffer(buffer)
+	{
+	}
+
+	virtual void entry()
+	{
+		uint32_t data[7U];
+
+		unsigned int value = 0U;
+		while (value < SPSC_VALUES) {
+			unsigned int count = 1U + value % 7U;
+			if (count > SPSC_VALUES - value)
+				count = SPSC_VALUES - value;
+
+			// Wait for the reader rather than overflow, on one CPU it must be let run
+			while (m_buffer.freeSpace() < count)
+				std::this_thread::yield();
+
+			for (unsigned int n = 0U; n < count; n++)
+				data[n] = value++;
+
+			m_buffer.addData(data, count);
+		}
+	}
+
+private:
+	CRingBuffer<uint32_t>& m_buffer;
+};
+
+static unsigned int testSPSC()
+{
+	unsigned int mismatches = 0U;
+
+	// Small enough that the writer keeps running into the reader and wrapping
+	CRingBuffer<uint32_t> buffer(64U, "SPSC", true);
+
+	CWriter writer(buffer);
+	writer.run();
+
+	uint32_t data[5U];
+
+	unsigned int value = 0U;
+	while (value < SPSC_VALUES) {
+		unsigned int count = 1U + value % 5U;
+		if (count > SPSC_VALUES - value)
+			count = SPSC_VALUES - value;
+
+		while (buffer.dataSize() < count)
+			std::this_thread::yield();
+
+		if (!buffer.getData(data, count)) {
+			mismatches++;
+			continue;
+		}
+
+		for (unsigned int n = 0U; n < count; n++, value++) {
+			if (data[n] != value)
+				mismatches++;
+		}
+	}
+
+	writer.wait();
+
+	if (!buffer.isEmpty())
+		mismatches++;
+
+	return mismatches;
+}
+
+int main()
+{
+	// The overflows are expected, keep them out of the output
+	::LogInitialise(".", "RingBufferTest", 0U, 0U);
+
+	unsigned int failures = 0U;
+
+	unsigned int mismatches = testRounding();
+	::printf("Power of two rounding: %u mismatches\n", mismatches);
+	failures += mismatches;
+
+	mismatches = testWrap();
+	::printf("Wrapped copies: %u mismatches\n", mismatches);
+	failures += mismatches;
+
+	mismatches = testOverflow(false);
+	::printf("Overflow, clearing: %u mismatches\n", mismatches);
+	failures += mismatches;
+
+	mismatches = testOverflow(true);
+	::printf("Overflow, SPSC dropping: %u mismatches\n", mismatches);
+	failures += mismatches;
+
+	mismatches = testSPSC();
+	::printf("SPSC counter: %u values, %u mismatches\n", SPSC_VALUES, mismatches);
+	failures += mismatches;
+
+	::LogFinalise();
+
+	return failures == 0U ? 0 : 1;
+}
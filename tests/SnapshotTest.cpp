@@ -0,0 +1,227 @@
+/*
+ *   Copyright (C) 2026 by agent
+ *
+ *   This program is free software; you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation; either version 2 of the License, or
+ *   (at your option) any later version.
+ *
+ *   This program is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with this program; if not, write to the Free Software
+ *   Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+ */
+
+
+#include "DMRLookup.h"
+#include "NXDNLookup.h"
+#include "Thread.h"
+#include "Log.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <ctime>
+
+// Reader threads look Ids up without a pause while the lookup file is
+// rewritten and reloaded over and over, alternating between two versions.
+// Every answer must come whole from one version or the other, and the
+// readers must go as fast, per second of their own CPU time, as they do
+// while nothing is being reloaded.
+
+const unsigned int READERS  = 3U;
+const unsigned int IDS      = 20000U;
+const unsigned int PHASE_MS = 1000U;
+
+// Lookups between looks at the clock and the phase
+const unsigned int CHUNK = 1024U;
+
+enum PHASE {
+	PHASE_QUIET,
+	PHASE_RELOAD,
+	PHASE_STOP
+};
+
+static std::atomic<unsigned int> g_phase(PHASE_QUIET);
+
+static double threadSeconds()
+{
+	struct timespec ts;
+	::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+
+	return double(ts.tv_sec) + double(ts.tv_nsec) / 1.0E9;
+}
+
+// Each version of the file gives an Id its own callsign, of a different length so the index sees a change
+static void callsignOf(unsigned int version, unsigned int i, char* callsign)
+{
+	::sprintf(callsign, version == 0U ? "A%u" : "BB%u", i);
+}
+
+template<class L> class CReader : public CThread {
+public:
+	CReader(L* lookup, unsigned int firstId, unsigned int seed) :
+	CThread(),
+	m_lookup(lookup),
+	m_firstId(firstId),
+	m_seed(seed),
+	m_bad(0U),
+	m_changed(0U)
+	{
+		for (unsigned int i = 0U; i < 2U; i++) {
+			m_count[i]   = 0U;
+			m_seconds[i] = 0.0;
+		}
+	}
+
+	virtual void entry()
+	{
+		unsigned int seed = m_seed;
+
+		for (;;) {
+			unsigned int phase = g_phase.load();
+			if (phase == PHASE_STOP)
+				break;
+
+			double start = threadSeconds();
+
+			for (unsigned int n = 0U; n < CHUNK; n++) {
+				seed = seed * 1103515245U + 12345U;
+				unsigned int i = (seed >> 8) % IDS;
+
+				char found[ID_CALLSIGN_LENGTH];
+				m_lookup->findCS(m_firstId + i, found);
+
+				char a[ID_CALLSIGN_LENGTH], b[ID_CALLSIGN_LENGTH];
+				callsignOf(0U, i, a);
+				callsignOf(1U, i, b);
+				if (::strcmp(found, b) == 0)
+					m_changed++;
+				else if (::strcmp(found, a) != 0)
+					m_bad++;
+
+				if (!m_lookup->exists(m_firstId + i))
+					m_bad++;
+			}
+
+			m_count[phase]   += CHUNK;
+			m_seconds[phase] += threadSeconds() - start;
+		}
+	}
+
+	L*           m_lookup;
+	unsigned int m_firstId;
+	unsigned int m_seed;
+	unsigned int m_bad;
+	unsigned int m_changed;
+	unsigned int m_count[2U];
+	double       m_seconds[2U];
+};
+
+static bool writeFile(const std::string& filename, unsigned int version, unsigned int firstId, char separator)
+{
+	FILE* fp = ::fopen(filename.c_str(), "wt");
+	if (fp == NULL)
+		return false;
+
+	::fprintf(fp, "# Version %u\n", version);
+
+	for (unsigned int i = 0U; i < IDS; i++) {
+		char callsign[ID_CALLSIGN_LENGTH];
+		callsignOf(version, i, callsign);
+		::fprintf(fp, "%u%c%s\n", firstId + i, separator, callsign);
+	}
+
+	::fclose(fp);
+
+	return true;
+}
+
+template<class L> static bool stress(const char* name, const std::string& index, unsigned int firstId, char separator)
+{
+	std::string filename = std::string("tests/") + name + "Stress.txt";
+	if (!writeFile(filename, 0U, firstId, separator)) {
+		::fprintf(stderr, "%s: cannot write %s\n", name, filename.c_str());
+		return false;
+	}
+
+	L* lookup = new L(filename, index, 0U);
+	lookup->read();
+
+	g_phase = PHASE_QUIET;
+
+	CReader<L>* readers[READERS];
+	for (unsigned int i = 0U; i < READERS; i++) {
+		readers[i] = new CReader<L>(lookup, firstId, i + 1U);
+		readers[i]->run();
+	}
+
+	CThread::sleep(PHASE_MS);
+
+	// Reloads back to back, the reads and parses compete with the readers for the CPU but must not stop them
+	g_phase = PHASE_RELOAD;
+
+	unsigned int reloads = 0U;
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now() + std::chrono::milliseconds(PHASE_MS);
+	while (std::chrono::steady_clock::now() < end) {
+		reloads++;
+		writeFile(filename, reloads & 0x01U, firstId, separator);
+		lookup->read();
+	}
+
+	g_phase = PHASE_STOP;
+
+	unsigned int bad = 0U;
+	unsigned int changed = 0U;
+	unsigned int count[2U] = {0U, 0U};
+	double seconds[2U] = {0.0, 0.0};
+	for (unsigned int i = 0U; i < READERS; i++) {
+		readers[i]->wait();
+
+		bad     += readers[i]->m_bad;
+		changed += readers[i]->m_changed;
+		for (unsigned int n = 0U; n < 2U; n++) {
+			count[n]   += readers[i]->m_count[n];
+			seconds[n] += readers[i]->m_seconds[n];
+		}
+
+		delete readers[i];
+	}
+
+	lookup->stop();
+
+	::remove(filename.c_str());
+	if (!index.empty())
+		::remove(index.c_str());
+
+	double quiet  = double(count[PHASE_QUIET])  / seconds[PHASE_QUIET]  / 1.0E6;
+	double reload = double(count[PHASE_RELOAD]) / seconds[PHASE_RELOAD] / 1.0E6;
+
+	::printf("%s: %u reloads, %.2f M lookups per CPU second quiet, %.2f M while reloading, %.2f M/s and %.2f M/s overall, %u bad lookups\n",
+		name, reloads, quiet, reload, double(count[PHASE_QUIET]) / (PHASE_MS / 1000.0) / 1.0E6,
+		double(count[PHASE_RELOAD]) / (PHASE_MS / 1000.0) / 1.0E6, bad);
+
+	// The second version must have been seen, or the reloads did not reach the readers
+	return bad == 0U && changed > 0U && reloads > 1U && reload > quiet * 0.5;
+}
+
+int main()
+{
+	// No log file and nothing on the console
+	::LogInitialise(".", "SnapshotTest", 0U, 0U);
+
+	// The DMR table is parsed each time, the NXDN one goes through the index
+	bool ok = stress<CDMRLookup>("DMRLookup", "", 1000000U, ' ');
+	ok = stress<CNXDNLookup>("NXDNLookup", "tests/NXDNLookupStress.idx", 1U, ',') && ok;
+
+	::LogFinalise();
+
+	return ok ? 0 : 1;
+}